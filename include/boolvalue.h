@@ -17,17 +17,11 @@ namespace SmartTpl {
  */
 class BoolValue : public Value
 {
-private:
-    /**
-     *  The actual boolean value
-     */
-    const bool _value;
-
 public:
     /**
-     *  Constructors
+     *  Constructors, the actual boolean value is stored in the base class
      */
-    BoolValue(bool value) : _value(value) {}
+    BoolValue(bool value) : Value(Type::Bool, value) {}
 
     /**
      *  Destructor
@@ -40,7 +34,7 @@ public:
      */
     std::string toString() const override
     {
-        return (_value) ? "true" : "false";
+        return (_numeric) ? "true" : "false";
     };
 
     /**
@@ -49,7 +43,7 @@ public:
      */
     numeric_t toNumeric() const override
     {
-        return _value;
+        return _numeric;
     };
 
     /**
@@ -58,7 +52,7 @@ public:
      */
     bool toBoolean() const override
     {
-        return _value;
+        return _numeric;
     };
 
     /**
@@ -28,6 +28,53 @@ namespace SmartTpl {
  */
 using Callback = std::function<VariantValue()>;
 
+/**
+ *  Definitions of callbacks that return a plain scalar, these are called
+ *  directly by the template code every time a scalar of this type is needed,
+ *  without creating a VariantValue
+ */
+using NumericCallback = std::function<numeric_t()>;
+using BooleanCallback = std::function<bool()>;
+using DoubleCallback = std::function<double()>;
+
+/**
+ *  Definition of a callback that produces a string, it should append the
+ *  string to the buffer that is passed to it
+ */
+using StringCallback = std::function<void(std::string &buffer)>;
+
+/**
+ *  How long the value returned by a callback may be used. When the value is
+ *  cached per process call, it is stored with the template that is being
+ *  processed, so the data object can safely be used by multiple threads
+ */
+enum class Caching : int {
+    None        =   0,      // the callback is called every time the value is used
+    Process     =   1,      // the callback is called once per process call
+    Forever     =   2       // the callback is called only once
+};
+
+/**
+ *  Definition of a generator, every call should store the next element in
+ *  the value that is passed to it, and return false if there are no more
+ *  elements
+ */
+using Generator = std::function<bool(VariantValue &value)>;
+
+/**
+ *  Definition of an iterable callback, this is called every time a template
+ *  starts iterating over the variable, and should return a new generator
+ */
+using Iterable = std::function<Generator()>;
+
+/**
+ *  Definition of a resolver, this is called for variables that were not
+ *  assigned, and should return the value of the variable, or nullptr if the
+ *  variable does not exist. The returned value is not destructed by the
+ *  library, it should stay valid until the template was processed
+ */
+using Resolver = std::function<const Value*(const char *name, size_t size)>;
+
 
 /**
  *  End of namespace
@@ -15,6 +15,18 @@
 
 typedef int64_t numeric_t;
 
+/**
+ *  One step in a path of members that is resolved with a single call, the
+ *  name is a null pointer when the member is accessed by its position, and
+ *  the hash is the one calculated by SmartTpl::MapValue::hash()
+ */
+struct smart_tpl_path_element {
+    const char *name;
+    size_t      size;
+    size_t      hash;
+    size_t      position;
+};
+
 /**
  *  Structure with all the callbacks
  */
@@ -50,4 +62,100 @@ struct smart_tpl_callbacks {
     const void *(*params_append_boolean)(void *userdata, const void *parameters, int boolean);
     void        (*mark_failed)          (void *userdata, const char *message);
     int         (*throw_exception)      (void *userdata, const char *message);
+    int         (*iterator_fetch)       (void *userdata, void *iterator, const char *key, size_t keysize, const char *value, size_t valuesize);
+    const void *(*vector)               (void *userdata, const void *variable);
+    size_t      (*vector_size)          (void *userdata, const void *vector);
+    const void *(*vector_data)          (void *userdata, const void *vector);
+    size_t      (*vector_stride)        (void *userdata);
+    void        (*vector_bind)          (void *userdata, const void *vector, size_t index, const char *key, size_t keysize, const char *value, size_t valuesize);
+    const void *(*path)                 (void *userdata, const void *variable, const struct smart_tpl_path_element *path, size_t count);
+    const void *(*slot_path)            (void *userdata, size_t slot, const struct smart_tpl_path_element *path, size_t count);
+    size_t      (*member_count)         (void *userdata, const void *variable);
+    const void *(*modify_pipeline)      (void *userdata, const void *variable, void *modifier, const void *parameters);
+    void        (*output_pipeline)      (void *userdata, const void *variable, void *modifier, const void *parameters, int escape);
+    const void *(*counter)              (void *userdata, const char *name, size_t size, numeric_t value);
+    void        (*output_double)        (void *userdata, double number);
+    int         (*pure_modifier)        (void *userdata, const void *modifier);
+};
+
+/**
+ *  Type tags of values (these are the same as SmartTpl::Value::Type)
+ */
+#define SMART_TPL_TYPE_NULL     0
+#define SMART_TPL_TYPE_BOOL     1
+#define SMART_TPL_TYPE_NUMERIC  2
+#define SMART_TPL_TYPE_DOUBLE   3
+#define SMART_TPL_TYPE_NUMERIC_CALLBACK 8
+#define SMART_TPL_TYPE_BOOLEAN_CALLBACK 9
+#define SMART_TPL_TYPE_DOUBLE_CALLBACK  10
+
+/**
+ *  Every value object starts with this header: the pointer to the virtual
+ *  table, the type tag, and the scalar for null, boolean, numeric and
+ *  floating point values. Values that are produced by a typed callback hold
+ *  the function that calculates them, it is called with the value itself.
+ */
+struct smart_tpl_value {
+    const void *vtable;
+    int         type;
+    union {
+        numeric_t   numeric;
+        double      fp;
+        numeric_t (*numeric_callback)(const void *variable);
+        int       (*boolean_callback)(const void *variable);
+        double    (*double_callback)(const void *variable);
+    } scalar;
 };
+
+/**
+ *  Helper functions to convert a variable to a scalar, the scalar is read
+ *  directly from the value if it holds one, a typed callback of the same
+ *  type is called directly, and only for other values the library is called
+ */
+static inline numeric_t smart_tpl_numeric(struct smart_tpl_callbacks *callbacks, void *userdata, const void *variable)
+{
+    const struct smart_tpl_value *value = (const struct smart_tpl_value *)variable;
+    if (value->type <= SMART_TPL_TYPE_NUMERIC) return value->scalar.numeric;
+    if (value->type == SMART_TPL_TYPE_DOUBLE) return (numeric_t)value->scalar.fp;
+    if (value->type == SMART_TPL_TYPE_NUMERIC_CALLBACK) return value->scalar.numeric_callback(variable);
+    return callbacks->to_numeric(userdata, variable);
+}
+
+static inline double smart_tpl_double(struct smart_tpl_callbacks *callbacks, void *userdata, const void *variable)
+{
+    const struct smart_tpl_value *value = (const struct smart_tpl_value *)variable;
+    if (value->type <= SMART_TPL_TYPE_NUMERIC) return (double)value->scalar.numeric;
+    if (value->type == SMART_TPL_TYPE_DOUBLE) return value->scalar.fp;
+    if (value->type == SMART_TPL_TYPE_DOUBLE_CALLBACK) return value->scalar.double_callback(variable);
+    return callbacks->to_double(userdata, variable);
+}
+
+static inline int smart_tpl_boolean(struct smart_tpl_callbacks *callbacks, void *userdata, const void *variable)
+{
+    const struct smart_tpl_value *value = (const struct smart_tpl_value *)variable;
+    if (value->type <= SMART_TPL_TYPE_NUMERIC) return value->scalar.numeric != 0;
+    if (value->type == SMART_TPL_TYPE_DOUBLE) return value->scalar.fp != 0.0;
+    if (value->type == SMART_TPL_TYPE_BOOLEAN_CALLBACK) return value->scalar.boolean_callback(variable);
+    return callbacks->to_boolean(userdata, variable);
+}
+
+/**
+ *  Helper to write the result of arithmetic, floating point results are only
+ *  written as integers when they have no fraction (the generated C code does
+ *  not know the type of the result, so this is selected by the C compiler)
+ */
+static inline void smart_tpl_output_integer(struct smart_tpl_callbacks *callbacks, void *userdata, numeric_t number)
+{
+    callbacks->output_numeric(userdata, number);
+}
+
+static inline void smart_tpl_output_fp(struct smart_tpl_callbacks *callbacks, void *userdata, double number)
+{
+    if (number > -9.2e18 && number < 9.2e18 && (double)(numeric_t)number == number) callbacks->output_numeric(userdata, (numeric_t)number);
+    else callbacks->output_double(userdata, number);
+}
+
+#ifndef __cplusplus
+#define smart_tpl_output_number(callbacks, userdata, number) \
+    _Generic((number), double: smart_tpl_output_fp, default: smart_tpl_output_integer)(callbacks, userdata, number)
+#endif
@@ -34,24 +34,70 @@ private:
     std::list<std::shared_ptr<Value>> _managed_values;
 
     /**
-     *  All modifiers
+     *  The modifiers that were registered with this object, the built-in
+     *  modifiers are shared by all data objects and are not stored here
      *  @var std::map
      */
     std::map<std::string, Modifier*> _modifiers;
 
+    /**
+     *  The data object that is used for everything that is not found here
+     *  @var const Data*
+     */
+    const Data *_parent = nullptr;
+
+    /**
+     *  Function that is called for variables that are not assigned
+     *  @var Resolver
+     */
+    Resolver _resolver;
+
+    /**
+     *  Should the values returned by the resolver be cached during a run?
+     *  @var bool
+     */
+    bool _cache = false;
+
+    /**
+     *  Look up a variable that was assigned to this object or to one of its parents
+     *  @param  name        the name
+     *  @return Value       nullptr if it was not assigned
+     */
+    const Value *assigned(const char *name) const;
+
+    /**
+     *  Ask the resolvers of this object and its parents for a variable
+     *  @param  name        the name
+     *  @param  size        size of the name
+     *  @return Value       nullptr if no resolver knows the variable
+     */
+    const Value *resolve(const char *name, size_t size) const;
+
 public:
     /**
      *  Constructor
      */
     Data();
 
+    /**
+     *  Constructor for a data object that is layered on top of another one.
+     *  Variables and modifiers that are not assigned to this object are looked
+     *  up in the parent, which is not copied, so constructing this object is
+     *  cheap even if the parent holds a lot of data
+     *  @param  parent      The parent, it should stay valid while this object is in use
+     */
+    explicit Data(const Data *parent) : _parent(parent) {}
+
     /**
      *  Copy constructor
      */
     Data(const Data &that)
     : _variables(that._variables),
       _managed_values(that._managed_values),
-      _modifiers(that._modifiers)
+      _modifiers(that._modifiers),
+      _parent(that._parent),
+      _resolver(that._resolver),
+      _cache(that._cache)
     {
     }
 
@@ -91,6 +137,16 @@ public:
     Data &assignManaged(const std::string &name, Value *value);
     Data &assignManaged(const std::string &name, std::shared_ptr<Value> &value);
 
+    /**
+     *  Assign a JSON document. The document is not converted into vectors and
+     *  maps, the members are looked up in the JSON text when the template
+     *  uses them, so only the parts of the document that are used are parsed
+     *  @param  name        Name of the variable
+     *  @param  json        The JSON text
+     *  @return Data        Same object for chaining
+     */
+    Data &assignJson(const std::string &name, std::string json);
+
     /**
      *  Assign a callback
      *  The callback will only be called when a variable with the given name
@@ -102,6 +158,53 @@ public:
      */
     Data &callback(const std::string &name, const Callback &call, bool cache = false);
 
+    /**
+     *  Assign a callback, and specify how long its value may be cached
+     *  @param  name        Name of the variable
+     *  @param  callback    Function to be called when the variable is accessed
+     *  @param  caching     How long may the value be cached?
+     *  @return Data        Same object for chaining
+     */
+    Data &callback(const std::string &name, const Callback &call, Caching caching);
+
+    /**
+     *  Assign a callback that returns a plain scalar or that writes a string.
+     *  These callbacks are called every time the template needs the value.
+     *  When the template needs a scalar of the type that the callback returns,
+     *  the generated code calls it directly, without a virtual call and
+     *  without creating a VariantValue
+     *  @param  name        Name of the variable
+     *  @param  callback    Function to be called when the variable is accessed
+     *  @return Data        Same object for chaining
+     */
+    Data &callbackNumeric(const std::string &name, const NumericCallback &call);
+    Data &callbackBoolean(const std::string &name, const BooleanCallback &call);
+    Data &callbackDouble(const std::string &name, const DoubleCallback &call);
+    Data &callbackString(const std::string &name, const StringCallback &call);
+
+    /**
+     *  Assign a variable that can be iterated over, but whose elements are
+     *  produced on demand. Every time a template starts a foreach loop over
+     *  the variable, the callback is called to create a new generator, from
+     *  which the elements are fetched in chunks of the given size
+     *  @param  name        Name of the variable
+     *  @param  callback    Function that creates a new generator
+     *  @param  chunk       Max number of elements to fetch at once
+     *  @return Data        Same object for chaining
+     */
+    Data &iterable(const std::string &name, const Iterable &callback, size_t chunk = 1);
+
+    /**
+     *  Install a resolver, that is called when a template uses a variable
+     *  that was not assigned. This allows you to only load the variables
+     *  that are actually used by a template. If the resolver is cached, it is
+     *  called at most once per variable every time a template is processed
+     *  @param  callback    Function that returns the value of a variable
+     *  @param  cache       Should we cache the values returned by the resolver?
+     *  @return Data        Same object for chaining
+     */
+    Data &resolver(const Resolver &callback, bool cache = false);
+
     /**
      *  Register a modifier
      *  @param  name        Name of the modifier
@@ -111,7 +214,9 @@ public:
     Data &modifier(const std::string &name, Modifier *mod);
 
     /**
-     *  Retrieve a variable pointer by name
+     *  Retrieve a variable pointer by name. Assigned variables take precedence
+     *  over resolvers: the variables of this object and all of its parents are
+     *  checked before any resolver is called
      *  @param  name        the name
      *  @param  size        size of the name
      *  @return Value
@@ -132,6 +237,28 @@ public:
      *  @return boolean
      */
     bool contains(const Value *value) const;
+
+    /**
+     *  Are variables resolved on demand by this object or by one of its parents?
+     *  @return bool
+     */
+    bool resolving() const
+    {
+        return _resolver || (_parent && _parent->resolving());
+    }
+
+    /**
+     *  Can the variables that are resolved on demand be cached during a run?
+     *  @return bool
+     */
+    bool caching() const
+    {
+        // every resolver in the chain should allow it
+        if (_resolver && !_cache) return false;
+
+        // check the parent
+        return !_parent || _parent->caching();
+    }
 };
 
 /**
@@ -17,18 +17,12 @@ namespace SmartTpl {
  */
 class DoubleValue : public Value
 {
-private:
-    /**
-     *  The actual double
-     */
-    const double _value;
-
 public:
     /**
-     *  Constructors
+     *  Constructors, the actual double is stored in the base class
      */
-    DoubleValue(double value) : _value(value) {}
-    DoubleValue(float value) : _value(value) {};
+    DoubleValue(double value) : Value(value) {}
+    DoubleValue(float value) : Value((double)value) {};
 
     /**
      *  Destructor
@@ -41,7 +35,7 @@ public:
      */
     std::string toString() const override
     {
-        return std::to_string(_value);
+        return std::to_string(_double);
     };
 
     /**
@@ -50,7 +44,7 @@ public:
      */
     numeric_t toNumeric() const override
     {
-        return _value;
+        return _double;
     };
 
     /**
@@ -59,7 +53,7 @@ public:
      */
     bool toBoolean() const override
     {
-        return _value;
+        return _double;
     };
 
     /**
@@ -68,7 +62,7 @@ public:
      */
     double toDouble() const override
     {
-        return _value;
+        return _double;
     };
 
     /**
@@ -59,6 +59,23 @@ public:
      *  @return Variant
      */
     virtual VariantValue key() const = 0;
+
+    /**
+     *  Fetch a number of elements at once, and move past them
+     *
+     *  Templates call this method to iterate, so that a foreach loop does not
+     *  need a couple of virtual calls for every element. The default
+     *  implementation uses the other methods, and moves only one element at
+     *  a time, so that elements are not produced before the template needs
+     *  them. You can override it if your iterator can produce its elements
+     *  more efficiently in batches.
+     *
+     *  @param  keys        Array in which the keys should be stored, or nullptr if the keys are not needed
+     *  @param  values      Array in which the values should be stored
+     *  @param  max         Size of the arrays
+     *  @return size_t      Number of elements that were fetched, 0 when the end was reached
+     */
+    virtual size_t fetch(VariantValue *keys, VariantValue *values, size_t max);
 };
 
 /**
@@ -14,23 +14,73 @@ namespace SmartTpl {
 
 /**
  *  Class definition
+ *
+ *  The members are stored in a vector in the order in which they were
+ *  inserted, an open addressing hash table with positions in this vector is
+ *  used to look up members by name without having to construct a std::string,
+ *  and a second vector holds the positions sorted by key, so that the members
+ *  can be iterated and accessed by position in key order just like before.
+ *  Members are never moved once the map is filled, so pointers to them stay
+ *  valid, and reading the map never modifies it.
  */
 class MapValue : public Value
 {
 private:
     /**
-     *  The actual vector
+     *  The members, in the order in which they were inserted
+     *  @var    std::vector
+     */
+    std::vector<std::pair<std::string, VariantValue>> _value;
+
+    /**
+     *  Hash table with positions in the _value vector, plus one (a zero is
+     *  an empty slot), the size is always a power of two
+     *  @var    std::vector
+     */
+    std::vector<uint32_t> _index;
+
+    /**
+     *  Positions in the _value vector, sorted by key
+     *  @var    std::vector
+     */
+    std::vector<uint32_t> _order;
+
+    /**
+     *  Find the position of a member
+     *  @param  name        name of the member
+     *  @param  size        size of the name
+     *  @param  hash        hash of the name
+     *  @return size_t      position, or the number of members if it does not exist
+     */
+    size_t find(const char *name, size_t size, size_t hash) const;
+    size_t find(const char *name, size_t size) const { return find(name, size, hash(name, size)); }
+
+    /**
+     *  Add a member, or do nothing if there already is a member with this key
+     *  @param  key
+     *  @param  value
      */
-    std::map<std::string, VariantValue> _value;
+    void store(std::string &&key, VariantValue &&value);
+
+    /**
+     *  Rebuild the hash table after the members were changed
+     */
+    void rebuild();
+
+    /**
+     *  Set up the sorted order and the hash table, after the members were
+     *  assigned in key order
+     */
+    void initialize();
 
 public:
     /**
      *  Constructors
      */
-    MapValue() : _value() {};
-    MapValue(const std::map<std::string, VariantValue>& value) : _value(value) {};
-    MapValue(std::map<std::string, VariantValue>&& value) : _value(std::move(value)) {};
-    MapValue(const std::initializer_list<std::map<std::string, VariantValue>::value_type>& value) : _value(value) {};
+    MapValue() : Value(Type::Map) {};
+    MapValue(const std::map<std::string, VariantValue>& value) : Value(Type::Map), _value(value.begin(), value.end()) { initialize(); };
+    MapValue(std::map<std::string, VariantValue>&& value);
+    MapValue(const std::initializer_list<std::map<std::string, VariantValue>::value_type>& value) : MapValue(std::map<std::string, VariantValue>(value)) {};
 
     /**
      *  Destructor
@@ -83,11 +133,11 @@ public:
      */
     VariantValue member(const char *name, size_t size) const override
     {
-        // look for a value with name
-        auto iter = _value.find(std::string(name, size));
+        // look for the position of the member
+        auto position = find(name, size);
 
         // found it? return it
-        if (iter != _value.end()) return iter->second;
+        if (position < _value.size()) return _value[position].second;
 
         // didn't see it? :( let's just return nullptr then
         return nullptr;
@@ -112,14 +162,44 @@ public:
         // if position is higher than the amount of items in the map we just return nullptr
         if (position >= memberCount()) return nullptr;
 
-        // get an iterator to the begin of the map
-        auto iter = _value.begin();
+        // return the value at this position in key order
+        return _value[_order[position]].second;
+    }
 
-        // advance it by position
-        std::advance(iter, position);
+    /**
+     *  Calculate the hash of a member name, this is the same hash that is used
+     *  by the lookup() method, so it can be calculated in advance
+     *  @param  name        name of the member
+     *  @param  size        size of the name
+     *  @return size_t
+     */
+    static size_t hash(const char *name, size_t size);
 
-        // return the value
-        return iter->second;
+    /**
+     *  Direct access to a member, without copying it
+     *  @param  name        name of the member
+     *  @param  size        size of the name
+     *  @param  hash        hash of the name
+     *  @return const VariantValue*     nullptr if there is no such member
+     */
+    const VariantValue *lookup(const char *name, size_t size, size_t hash) const
+    {
+        // look for the position of the member
+        auto position = find(name, size, hash);
+
+        // return a pointer to it if it exists
+        return position < _value.size() ? &_value[position].second : nullptr;
+    }
+
+    /**
+     *  Direct access to a member at a certain position, without copying it
+     *  @param  position    position of the member
+     *  @return const VariantValue*     nullptr if there is no such member
+     */
+    const VariantValue *lookup(size_t position) const
+    {
+        // return a pointer to the member at this position in key order, if it exists
+        return position < _order.size() ? &_value[_order[position]].second : nullptr;
     }
 
     /**
@@ -127,17 +207,25 @@ public:
      *  feel free to return nullptr if you don't want to be able to iterate
      *  over your type
      *
+     *  The iterator refers to the elements of this value instead of copying
+     *  them, so it should not outlive this object, or be used after the
+     *  value was modified
+     *
      *  @return Newly allocated Iterator
      */
     Iterator *iterator() const override;
 
     /**
-     *  A few rather basic inserters to expand your map later on
+     *  A few rather basic inserters to expand your map later on, just like
+     *  std::map::insert() nothing happens if the key already exists. Inserting
+     *  keys in sorted order takes constant time, other keys only move the
+     *  positions in the sorted order. The map should be filled before it is
+     *  shared, inserting moves the members when the vector grows
      */
     template<typename ...Args>
-    void insert(const std::string &key, Args&&... args) { _value.insert(std::make_pair(key, args...)); };
+    void insert(const std::string &key, Args&&... args) { store(std::string(key), VariantValue(std::forward<Args>(args)...)); };
     template<typename ...Args>
-    void insert(std::string &&key, Args&&... args) { _value.insert(std::make_pair(std::move(key), args...)); };
+    void insert(std::string &&key, Args&&... args) { store(std::move(key), VariantValue(std::forward<Args>(args)...)); };
 };
 
 /**
@@ -40,9 +40,41 @@ public:
      *  @param  params       Parameters used for this modification
      *  @return VariantValue A new value object
      *  @note   In case you end up NOT modifying the input, please throw a NoModification
-     *          exception.
+     *          exception. Throwing is expensive, so modifiers that often leave
+     *          their input alone should also implement the apply() method.
      */
     virtual VariantValue modify(const Value &input, const Parameters &params) = 0;
+
+    /**
+     *  Modify a variable value without throwing exceptions
+     *
+     *  This is the method that is called by the template engine. When it
+     *  returns false the template uses the original input. The default
+     *  implementation calls modify(), so that modifiers that were written for
+     *  older versions keep working.
+     *
+     *  @param  input        Initial value
+     *  @param  params       Parameters used for this modification
+     *  @param  result       The new value, only used when true is returned
+     *  @return bool         Was the input modified?
+     */
+    virtual bool apply(const Value &input, const Parameters &params, VariantValue &result)
+    {
+        // older modifiers throw an exception when they do not modify the input
+        try
+        {
+            // store the new value
+            result = modify(input, params);
+
+            // the input was modified
+            return true;
+        }
+        catch (const NoModification &exception)
+        {
+            // the input stays the same
+            return false;
+        }
+    }
 };
 
 /**
@@ -21,7 +21,7 @@ public:
     /**
      *  Constructors
      */
-    NullValue() {}
+    NullValue() : Value(Type::Null) {}
 
     /**
      *  Destructor
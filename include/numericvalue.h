@@ -17,19 +17,13 @@ namespace SmartTpl {
  */
 class NumericValue : public Value
 {
-private:
-    /**
-     *  The actual numeric value
-     */
-    const numeric_t _value;
-
 public:
     /**
-     *  Constructors
+     *  Constructors, the actual numeric value is stored in the base class
      */
-    NumericValue(int64_t value) : _value(value) {}
-    NumericValue(int32_t value) : _value(value) {};
-    NumericValue(int16_t value) : _value(value) {};
+    NumericValue(int64_t value) : Value(Type::Numeric, value) {}
+    NumericValue(int32_t value) : Value(Type::Numeric, value) {};
+    NumericValue(int16_t value) : Value(Type::Numeric, value) {};
 
     /**
      *  Destructor
@@ -42,7 +36,7 @@ public:
      */
     std::string toString() const override
     {
-        return std::to_string(_value);
+        return std::to_string(_numeric);
     };
 
     /**
@@ -51,7 +45,7 @@ public:
      */
     numeric_t toNumeric() const override
     {
-        return _value;
+        return _numeric;
     };
 
     /**
@@ -60,7 +54,7 @@ public:
      */
     bool toBoolean() const override
     {
-        return _value;
+        return _numeric;
     };
 
     /**
@@ -0,0 +1,87 @@
+/**
+ *  StringModifier.h
+ *
+ *  Base class for modifiers that turn a string into a different string. These
+ *  modifiers change a buffer in place, so that a number of them in a row
+ *  ("$a|trim|lower|truncate:40") all work on the same buffer, and no values
+ *  have to be created for the intermediate results.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl {
+
+/**
+ *  Class definition
+ */
+class StringModifier : public Modifier
+{
+public:
+    /**
+     *  Destructor
+     */
+    virtual ~StringModifier() {};
+
+    /**
+     *  Modify a string in place
+     *
+     *  @param  buffer       The string to modify
+     *  @param  params       Parameters used for this modification
+     *  @return bool         Was the string modified?
+     *  @note   When false is returned the buffer must be left untouched
+     */
+    virtual bool transform(std::string &buffer, const Parameters &params) = 0;
+
+    /**
+     *  Modify a variable value, and convert it into a different value
+     *
+     *  @param  input        Initial value
+     *  @param  params       Parameters used for this modification
+     *  @return VariantValue A new value object
+     *  @throws NoModification  If the string was not modified
+     */
+    virtual VariantValue modify(const Value &input, const Parameters &params) override
+    {
+        // the string to modify
+        std::string buffer(input.toString());
+
+        // the input stays the same if the string was not modified
+        if (!transform(buffer, params)) throw NoModification();
+
+        // expose the new value
+        return buffer;
+    }
+
+    /**
+     *  Modify a variable value without throwing exceptions, this is used
+     *  when the modifier is not part of a pipeline
+     *
+     *  @param  input        Initial value
+     *  @param  params       Parameters used for this modification
+     *  @param  result       The new value, only used when true is returned
+     *  @return bool         Was the input modified?
+     */
+    virtual bool apply(const Value &input, const Parameters &params, VariantValue &result) override
+    {
+        // the string to modify
+        std::string buffer(input.toString());
+
+        // the input stays the same if the string was not modified
+        if (!transform(buffer, params)) return false;
+
+        // store the new value
+        result = std::move(buffer);
+
+        // the input was modified
+        return true;
+    }
+};
+
+/**
+ *  End namespace
+ */
+}
@@ -27,9 +27,9 @@ public:
     /**
      *  Constructors
      */
-    StringValue(const char* value) : _value(value) {}
-    StringValue(const char* value, size_t len) : _value(value, len) {};
-    StringValue(std::string value) : _value(std::move(value)) {};
+    StringValue(const char* value) : Value(Type::String), _value(value) {}
+    StringValue(const char* value, size_t len) : Value(Type::String), _value(value, len) {};
+    StringValue(std::string value) : Value(Type::String), _value(std::move(value)) {};
 
     /**
      *  Destructor
@@ -79,6 +79,19 @@ public:
      */
     virtual ~Template();
 
+    /**
+     *  Preload a compiled template (*.so file)
+     *
+     *  The library is loaded with all its symbols resolved right away, and it
+     *  stays in memory for the rest of the lifetime of the process. Templates
+     *  that are later constructed from the same file share the loaded library,
+     *  and do not pay the lazy binding costs during their first run.
+     *
+     *  @param  filename           Path to the shared library
+     *  @throws std::runtime_error If the library could not be loaded
+     */
+    static void preload(const std::string &filename);
+
     /**
      *  Deleted assign operator
      *  @param  that
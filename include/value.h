@@ -29,12 +29,81 @@ class VariantValue;
  */
 class Value
 {
+public:
+    /**
+     *  The type of a value
+     *
+     *  The built-in value classes tag themselves with their type. For values
+     *  of type Null, Bool, Numeric and Double, the scalar is also stored in the
+     *  value object itself, so that the template code can read it without a
+     *  virtual call. Your own classes are tagged as Custom, unless they pass a
+     *  different type to the constructor. The callback types are reserved for
+     *  the values that are registered with Data::callbackNumeric() and friends,
+     *  these hold a function that the template code calls to get the scalar.
+     */
+    enum class Type : int {
+        Null        =   0,
+        Bool        =   1,
+        Numeric     =   2,
+        Double      =   3,
+        String      =   4,
+        Vector      =   5,
+        Map         =   6,
+        Custom      =   7,
+        NumericCallback =   8,
+        BooleanCallback =   9,
+        DoubleCallback  =   10
+    };
+
+protected:
+    /**
+     *  The type tag
+     *
+     *  The layout of the type tag and the scalar is known to the generated
+     *  code, and it is mirrored by struct smart_tpl_value in callbacks.h
+     *
+     *  @var    Type
+     */
+    Type _type = Type::Custom;
+
+    /**
+     *  The scalar representation, only in use by values of type Null, Bool,
+     *  Numeric (the numeric member) and Double (the double member), values
+     *  of the callback types store the function that calculates the scalar
+     *  (it is called with a pointer to the value itself)
+     */
+    union
+    {
+        numeric_t _numeric = 0;
+        double _double;
+        void (*_function)();
+    };
+
+    /**
+     *  Constructors
+     *  @param  type        the type tag
+     *  @param  value       the scalar
+     */
+    Value() {}
+    Value(Type type) : _type(type) {}
+    Value(Type type, numeric_t value) : _type(type), _numeric(value) {}
+    Value(double value) : _type(Type::Double), _double(value) {}
+
 public:
     /**
      *  Destructor
      */
     virtual ~Value() {};
 
+    /**
+     *  The type of the value
+     *  @return Type
+     */
+    Type type() const
+    {
+        return _type;
+    }
+
     /**
      *  Convert the value to a string
      *  @return std::string
@@ -14,26 +14,75 @@ namespace SmartTpl {
 
 /**
  *  Class definition
+ *
+ *  Null, boolean, numeric and floating point values, and short strings, are
+ *  stored inline in the object, only containers, long strings and your own
+ *  Value objects are allocated and wrapped in a shared pointer.
  */
 class VariantValue : public Value
 {
 private:
     /**
-     *  A regular Value object that we wrapped around
+     *  A regular Value object that we wrapped around, this is empty if the
+     *  value is stored inline
+     *  @var    std::shared_ptr<Value>
      */
     std::shared_ptr<Value> _value;
 
+    /**
+     *  Buffer for short strings that are stored inline (the length of the
+     *  string is stored in the _numeric member of the base class)
+     *  @var    char[]
+     */
+    char _buffer[16];
+
+    /**
+     *  Copy the type tag and the scalar of the wrapped value
+     */
+    void tag();
+
+    /**
+     *  Store a string (inline if it is short enough)
+     *  @param  value
+     *  @param  size
+     */
+    void assign(const char *value, size_t size);
+    void assign(std::string &&value);
+
+    /**
+     *  Copy the inline representation of another value
+     *  @param  that
+     */
+    void copy(const VariantValue &that)
+    {
+        // copy the type and the scalar
+        Value::operator=(that);
+
+        // short strings also have their data in the buffer
+        if (!that._value && _type == Type::String) memcpy(_buffer, that._buffer, _numeric);
+    }
+
+    /**
+     *  Turn this object into a null value
+     */
+    void clear()
+    {
+        _value = nullptr;
+        _type = Type::Null;
+        _numeric = 0;
+    }
+
 public:
     /**
      *  Constructors, one for most scalar types
      */
-    VariantValue();
-    VariantValue(std::nullptr_t value);
-    VariantValue(bool value);
-    VariantValue(int16_t value);
-    VariantValue(int32_t value);
-    VariantValue(int64_t value);
-    VariantValue(double value);
+    VariantValue() : Value(Type::Null) {}
+    VariantValue(std::nullptr_t value) : Value(Type::Null) {}
+    VariantValue(bool value) : Value(Type::Bool, value) {}
+    VariantValue(int16_t value) : Value(Type::Numeric, value) {}
+    VariantValue(int32_t value) : Value(Type::Numeric, value) {}
+    VariantValue(int64_t value) : Value(Type::Numeric, value) {}
+    VariantValue(double value) : Value(value) {}
     VariantValue(const char* value);
     VariantValue(const char* value, size_t len);
     VariantValue(std::string value);
@@ -47,7 +96,7 @@ public:
     /**
      *  Constructor to wrap around your own Value objects
      */
-    VariantValue(const std::shared_ptr<Value> &value) : _value(value) {};
+    VariantValue(const std::shared_ptr<Value> &value) : _value(value) { tag(); };
 
     /**
      *  Do not allow us to create this directly from a Value*!
@@ -56,10 +105,10 @@ public:
     VariantValue(Value *value) = delete;
 
     /**
-     *  Copy and move constructors
+     *  Copy and move constructors, a moved-from object holds null
      */
-    VariantValue(const VariantValue &that) : _value(that._value) {}
-    VariantValue(VariantValue &&that) : _value(std::move(that._value)) {}
+    VariantValue(const VariantValue &that) : _value(that._value) { copy(that); }
+    VariantValue(VariantValue &&that) : _value(std::move(that._value)) { copy(that); that.clear(); }
 
     /**
      *  Destructor
@@ -69,12 +118,12 @@ public:
     /**
      *  Assignment operators
      */
-    VariantValue& operator=(std::nullptr_t value);
-    VariantValue& operator=(bool value);
-    VariantValue& operator=(int16_t value);
-    VariantValue& operator=(int32_t value);
-    VariantValue& operator=(int64_t value);
-    VariantValue& operator=(double value);
+    VariantValue& operator=(std::nullptr_t value) { clear(); return *this; }
+    VariantValue& operator=(bool value) { _value = nullptr; _type = Type::Bool; _numeric = value; return *this; }
+    VariantValue& operator=(int16_t value) { _value = nullptr; _type = Type::Numeric; _numeric = value; return *this; }
+    VariantValue& operator=(int32_t value) { _value = nullptr; _type = Type::Numeric; _numeric = value; return *this; }
+    VariantValue& operator=(int64_t value) { _value = nullptr; _type = Type::Numeric; _numeric = value; return *this; }
+    VariantValue& operator=(double value) { _value = nullptr; _type = Type::Double; _double = value; return *this; }
     VariantValue& operator=(const char* value);
     VariantValue& operator=(std::string value);
     VariantValue& operator=(const std::vector<VariantValue>& value);
@@ -83,49 +132,33 @@ public:
     VariantValue& operator=(const std::map<std::string, VariantValue>& value);
     VariantValue& operator=(std::map<std::string, VariantValue>&& value);
     VariantValue& operator=(const std::initializer_list<std::map<std::string, VariantValue>::value_type>& value);
-    VariantValue& operator=(const std::shared_ptr<Value> &value) { _value = value; return *this; }
-    VariantValue& operator=(const VariantValue &value) { _value = value._value; return *this; }
-    VariantValue& operator=(VariantValue &&value) { _value = std::move(value._value); value._value = nullptr; return *this; }
+    VariantValue& operator=(const std::shared_ptr<Value> &value) { _value = value; tag(); return *this; }
+    VariantValue& operator=(const VariantValue &value) { if (this != &value) { _value = value._value; copy(value); } return *this; }
+    VariantValue& operator=(VariantValue &&value) { if (this != &value) { _value = std::move(value._value); copy(value); value.clear(); } return *this; }
 
     /**
      *  Convert the value to a string
      *  @return std::string
      */
-    std::string toString() const override
-    {
-        // return the toString of the underlying Value
-        return _value->toString();
-    };
+    std::string toString() const override;
 
     /**
      *  Convert the variable to a numeric value
      *  @return numeric
      */
-    numeric_t toNumeric() const override
-    {
-        // return the toNumeric of the underlying Value
-        return _value->toNumeric();
-    };
+    numeric_t toNumeric() const override;
 
     /**
      *  Convert the variable to a boolean value
      *  @return bool
      */
-    bool toBoolean() const override
-    {
-        // return the toBoolean of the underlying Value
-        return _value->toBoolean();
-    };
+    bool toBoolean() const override;
 
     /**
      *  Convert the variable to a floating point value
      *  @return double
      */
-    double toDouble() const override
-    {
-        // return the toDoubleO of the underlying Value
-        return _value->toDouble();
-    };
+    double toDouble() const override;
 
     /**
      *  Get access to a member value
@@ -137,8 +170,8 @@ public:
      */
     VariantValue member(const char *name, size_t size) const override
     {
-        // return the member(const char*, size_t) of the underlying Value
-        return _value->member(name, size);
+        // values that are stored inline do not have members
+        return _value ? _value->member(name, size) : nullptr;
     }
 
     /**
@@ -147,8 +180,8 @@ public:
      */
     size_t memberCount() const override
     {
-        // return the memberCount() of the underlying Value
-        return _value->memberCount();
+        // values that are stored inline do not have members
+        return _value ? _value->memberCount() : 0;
     }
 
     /**
@@ -158,8 +191,8 @@ public:
      */
     VariantValue member(size_t position) const override
     {
-        // return the member(size_t) of the underlying Value
-        return _value->member(position);
+        // values that are stored inline do not have members
+        return _value ? _value->member(position) : nullptr;
     }
 
     /**
@@ -171,14 +204,24 @@ public:
      */
     Iterator *iterator() const override
     {
-        // return the iterator of the underlying Value
-        return _value->iterator();
+        // values that are stored inline can not be iterated over
+        return _value ? _value->iterator() : nullptr;
+    }
+
+    /**
+     *  The value object that is wrapped by this variant
+     *  @return const Value*        nullptr if the value is stored inline
+     */
+    const Value *wrapped() const
+    {
+        return _value.get();
     }
 
     /**
-     *  Equals and not equals to operators
+     *  Equals and not equals to operators, two variants are equal when they
+     *  wrap the same value, or when they hold the same inline value
      */
-    bool operator==(const VariantValue &that) const { return _value == that._value; }
+    bool operator==(const VariantValue &that) const;
     bool operator!=(const VariantValue &that) const { return !(*this == that); }
 };
 
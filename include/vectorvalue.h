@@ -27,10 +27,10 @@ public:
     /**
      *  Constructors
      */
-    VectorValue() : _value() {};
-    VectorValue(const std::vector<VariantValue>& value) : _value(value) {};
-    VectorValue(std::vector<VariantValue>&& value) : _value(std::move(value)) {};
-    VectorValue(const std::initializer_list<VariantValue>& value) : _value(value) {};
+    VectorValue() : Value(Type::Vector), _value() {};
+    VectorValue(const std::vector<VariantValue>& value) : Value(Type::Vector), _value(value) {};
+    VectorValue(std::vector<VariantValue>&& value) : Value(Type::Vector), _value(std::move(value)) {};
+    VectorValue(const std::initializer_list<VariantValue>& value) : Value(Type::Vector), _value(value) {};
 
     /**
      *  Destructor
@@ -117,10 +117,23 @@ public:
      *  feel free to return nullptr if you don't want to be able to iterate
      *  over your type
      *
+     *  The iterator refers to the elements of this value instead of copying
+     *  them, so it should not outlive this object, or be used after the
+     *  value was modified
+     *
      *  @return Newly allocated Iterator
      */
     Iterator *iterator() const override;
 
+    /**
+     *  Direct access to the elements
+     *  @return std::vector
+     */
+    const std::vector<VariantValue> &elements() const
+    {
+        return _value;
+    }
+
     /**
      *  Regular vector push_back calls to later on expand your vector
      */
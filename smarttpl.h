@@ -56,6 +56,7 @@
 #include "smarttpl/callbacks.h"
 #include "smarttpl/parameters.h"
 #include "smarttpl/modifier.h"
+#include "smarttpl/stringmodifier.h"
 #include "smarttpl/callback.h"
 #include "smarttpl/data.h"
 #include "smarttpl/template.h"
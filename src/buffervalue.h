@@ -0,0 +1,159 @@
+/**
+ *  BufferValue.h
+ *
+ *  The string that is modified by a pipeline of string modifiers. While the
+ *  pipeline is still open, the next modifier in the pipeline may change the
+ *  string in place. Once the last modifier was applied, the buffer is closed
+ *  and it behaves just like a regular string value.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class BufferValue : public Value
+{
+private:
+    /**
+     *  The actual string
+     *  @var    std::string
+     */
+    std::string _buffer;
+
+    /**
+     *  Is the pipeline that modifies the string still open?
+     *  @var    bool
+     */
+    bool _open;
+
+public:
+    /**
+     *  Constructor
+     *  @param  buffer      The string
+     *  @param  open        Can the string still be modified?
+     */
+    BufferValue(std::string &&buffer, bool open) :
+        Value(Type::String), _buffer(std::move(buffer)), _open(open) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~BufferValue() {}
+
+    /**
+     *  Access to the string, to modify it in place
+     *  @return std::string
+     */
+    std::string &buffer() { return _buffer; }
+    const std::string &buffer() const { return _buffer; }
+
+    /**
+     *  Can the string still be modified?
+     *  @return bool
+     */
+    bool open() const { return _open; }
+
+    /**
+     *  Close the pipeline, after this the string no longer changes
+     */
+    void close() { _open = false; }
+
+    /**
+     *  Reuse the object for the string of a new pipeline
+     *  @param  buffer      The string
+     *  @param  open        Can the string still be modified?
+     */
+    void reset(std::string &&buffer, bool open)
+    {
+        _buffer = std::move(buffer);
+        _open = open;
+    }
+
+    /**
+     *  Convert the value to a string
+     *  @return std::string
+     */
+    std::string toString() const override
+    {
+        return _buffer;
+    }
+
+    /**
+     *  Convert the variable to a numeric value
+     *  @return numeric
+     */
+    numeric_t toNumeric() const override
+    {
+        return StringValue(_buffer).toNumeric();
+    }
+
+    /**
+     *  Convert the variable to a boolean value
+     *  @return bool
+     */
+    bool toBoolean() const override
+    {
+        // just like in php an empty string and a string containing "0" are false
+        return !_buffer.empty() && _buffer != "0";
+    }
+
+    /**
+     *  Convert the variable to a floating point value
+     *  @return double
+     */
+    double toDouble() const override
+    {
+        return StringValue(_buffer).toDouble();
+    }
+
+    /**
+     *  Get access to a member value
+     *  @param  name        name of the member
+     *  @param  size        size of the name
+     *  @return VariantValue
+     */
+    VariantValue member(const char *name, size_t size) const override
+    {
+        return nullptr;
+    }
+
+    /**
+     *  Get access to the amount of members this value has
+     *  @return size_t
+     */
+    size_t memberCount() const override
+    {
+        return 0;
+    }
+
+    /**
+     *  Get access to a member at a certain position
+     *  @param  position    Position of the item we want to retrieve
+     *  @return VariantValue
+     */
+    VariantValue member(size_t position) const override
+    {
+        return nullptr;
+    }
+
+    /**
+     *  Strings can not be iterated over
+     *  @return Iterator
+     */
+    SmartTpl::Iterator *iterator() const override
+    {
+        return nullptr;
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
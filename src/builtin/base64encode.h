@@ -15,7 +15,7 @@ namespace SmartTpl { namespace Internal {
 /**
  *  Class definition
  */
-class Base64EncodeModifier : public Modifier
+class Base64EncodeModifier : public StringModifier
 {
 public:
     /**
@@ -24,21 +24,18 @@ public:
     virtual ~Base64EncodeModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @return bool        Was the string modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
-        // Get the base64 encoder
-        const Escaper *escaper = Escaper::get("base64");
+        // Call encode on the string
+        Escaper::get("base64")->encode(buffer);
 
-        // Turn our input into a string
-        std::string output(input.toString());
-
-        // Call encode and return the output
-        return escaper->encode(output);
+        // the string was modified
+        return true;
     }
 };
 
@@ -15,7 +15,7 @@ namespace SmartTpl { namespace Internal {
 /**
  *  Class definition
  */
-class CatModifier : public Modifier
+class CatModifier : public StringModifier
 {
 public:
     /**
@@ -24,21 +24,18 @@ public:
     virtual ~CatModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @return bool        Was the string modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
-        // copy the entire string
-        std::string output(input.toString());
+        // Loop through the parameters and add all of them to the string
+        for (auto &param : params) buffer.append(param.toString());
 
-        // Loop through the parameters and add all of them to the output string
-        for (auto &param : params) output.append(param.toString());
-
-        // return the output
-        return output;
+        // the string was modified
+        return true;
     }
 };
 
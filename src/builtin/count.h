@@ -27,12 +27,33 @@ public:
      *  Modify a value object
      *  @param  input
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @param  result      The modified value
+     *  @return bool        Was the input modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool apply(const Value &input, const SmartTpl::Parameters &params, VariantValue &result) override
     {
         // Simply return the member count
-        return (int64_t) input.memberCount();
+        result = (int64_t) input.memberCount();
+        return true;
+    }
+
+    /**
+     *  Modify a value object
+     *  @param  input
+     *  @param  params      Parameters used for this modification
+     *  @return VariantValue
+     *  @throws NoModification  If the input stays the same
+     */
+    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    {
+        // the modified value
+        VariantValue result;
+
+        // the template engine calls apply(), this is for the old interface
+        if (!apply(input, params, result)) throw NoModification();
+
+        // expose the modified value
+        return result;
     }
 };
 
@@ -27,9 +27,10 @@ public:
      *  Modify a value object
      *  @param  input
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @param  result      The modified value
+     *  @return bool        Was the input modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool apply(const Value &input, const SmartTpl::Parameters &params, VariantValue &result) override
     {
         // Let's just convert our input to a C string
         std::string str = input.toString();
@@ -43,7 +44,27 @@ public:
         }
 
         // Return the output
-        return output;
+        result = output;
+        return true;
+    }
+
+    /**
+     *  Modify a value object
+     *  @param  input
+     *  @param  params      Parameters used for this modification
+     *  @return VariantValue
+     *  @throws NoModification  If the input stays the same
+     */
+    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    {
+        // the modified value
+        VariantValue result;
+
+        // the template engine calls apply(), this is for the old interface
+        if (!apply(input, params, result)) throw NoModification();
+
+        // expose the modified value
+        return result;
     }
 };
 
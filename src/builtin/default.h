@@ -27,21 +27,42 @@ public:
      *  Modify a value object
      *  @param  input
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @param  result      The modified value
+     *  @return bool        Was the input modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool apply(const Value &input, const SmartTpl::Parameters &params, VariantValue &result) override
     {
 		// convert input to a string
 		auto value = input.toString();
 		
 		// leap out on non-empty strings
-		if (!value.empty()) throw NoModification();
-		
-        // input was empty, return the default that was passed as parameter
-		if (params.size() >= 1) return params[0].toString();
+		if (!value.empty()) return false;
 		
         // no parameter was given, strange
-        throw NoModification();
+        if (params.size() == 0) return false;
+
+        // input was empty, return the default that was passed as parameter
+        result = params[0].toString();
+        return true;
+    }
+
+    /**
+     *  Modify a value object
+     *  @param  input
+     *  @param  params      Parameters used for this modification
+     *  @return VariantValue
+     *  @throws NoModification  If the input stays the same
+     */
+    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    {
+        // the modified value
+        VariantValue result;
+
+        // the template engine calls apply(), this is for the old interface
+        if (!apply(input, params, result)) throw NoModification();
+
+        // expose the modified value
+        return result;
     }
 };
 
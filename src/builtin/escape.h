@@ -15,7 +15,7 @@ namespace SmartTpl { namespace Internal {
 /**
  *  Class definition
  */
-class EscapeModifier : public Modifier
+class EscapeModifier : public StringModifier
 {
 public:
     /**
@@ -24,12 +24,12 @@ public:
     virtual ~EscapeModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @return bool        Was the string modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
         // We default to the html encoder
         std::string encoder("html");
@@ -37,13 +37,11 @@ public:
         // But if we have at least 1 parameter the first argument is our encoding
         if (params.size() >= 1) encoder = params[0].toString();
 
-        const Escaper *escaper = Escaper::get(encoder);
+        // Call encode on the string
+        Escaper::get(encoder)->encode(buffer);
 
-        // Turn our input into a string
-        std::string output(input.toString());
-
-        // Call encode and return the output
-        return escaper->encode(output);
+        // the string was modified
+        return true;
     }
 };
 
@@ -24,18 +24,18 @@ public:
     virtual ~Nl2brModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @return bool        Was the string modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
-        // initialize our output
-        std::string output(input.toString());
+        // Replace the new lines with <br />
+        replace(buffer, "\n", "<br />");
 
-        // Replace the new lines with <br /> and return
-        return replace(output, "\n", "<br />");
+        // the string was modified
+        return true;
     }
 };
 
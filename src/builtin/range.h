@@ -1,7 +1,8 @@
 /**
  *  Range.h
  *
- *  Built-in "|range" modifier, which truncates a list to a certain amount of items
+ *  Built-in "|range" modifier, which truncates a list to a certain amount of items.
+ *  The result is a view on the original list, so nothing is copied
  *
  *  @author Toon Schoenmakers <toon.schoenmakers@copernica.com>
  *  @copyright 2014 Copernica BV
@@ -27,18 +28,17 @@ public:
      *  Modify a value object
      *  @param  input
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @param  result      The modified value
+     *  @return bool        Was the input modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool apply(const Value &input, const SmartTpl::Parameters &params, VariantValue &result) override
     {
         // if there are no parameters we're not touching the input
-        if (params.size() == 0) throw NoModification();
-
-        // try to retrieve the raw iterator
-        auto rawIter = input.iterator();
+        if (params.size() == 0) return false;
 
-        // if there's no raw iterator we just return the original input
-        if (!rawIter) throw NoModification();
+        // values that can not be iterated over are not touched
+        std::unique_ptr<SmartTpl::Iterator> iter(input.iterator());
+        if (!iter) return false;
 
         // get our limits
         numeric_t begin = 0;
@@ -53,25 +53,32 @@ public:
             end += begin;
         }
 
-        // initialize our output value
-        std::map<std::string, VariantValue> output;
+        // the items are counted from one, and the end is included
+        numeric_t first = std::max(begin, (numeric_t)1);
+        numeric_t length = std::max(end - first + 1, (numeric_t)0);
 
-        // let's keep a simple counter
-        numeric_t current = 1;
+        // return a view on the selected items
+        result = VariantValue(std::make_shared<SliceValue>(input, first - 1, length));
+        return true;
+    }
 
-        // loop over all our values
-        for (std::unique_ptr<Iterator> iter(rawIter); iter->valid(); iter->next(), ++current)
-        {
-            // if we're before our start we just continue
-            if (begin > current) continue;
-            else if (current > end) break; // if we're past our end we break out
+    /**
+     *  Modify a value object
+     *  @param  input
+     *  @param  params      Parameters used for this modification
+     *  @return VariantValue
+     *  @throws NoModification  If the input stays the same
+     */
+    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    {
+        // the modified value
+        VariantValue result;
 
-            // and assign to our map
-            output[iter->key().toString()] = iter->value();
-        }
+        // the template engine calls apply(), this is for the old interface
+        if (!apply(input, params, result)) throw NoModification();
 
-        // simply return our output, it'll be turned into a VariantValue automatically
-        return output;
+        // expose the modified value
+        return result;
     }
 };
 
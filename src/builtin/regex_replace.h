@@ -27,9 +27,10 @@ public:
      *  Modify a value object
      *  @param  input
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @param  result      The modified value
+     *  @return bool        Was the input modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool apply(const Value &input, const SmartTpl::Parameters &params, VariantValue &result) override
     {
         if (params.size() >= 2)
         {
@@ -48,17 +49,37 @@ public:
                                     ,input_str.begin(), input_str.end(), regex, replace_text);
 
                 // Turn stream into a string and return it
-                return stream.str();
+                result = stream.str();
+                return true;
             }
             catch (const boost::regex_error &error)
             {
                 // Return the original input in case of a failure
-                throw NoModification();
+                return false;
             }
         }
 
         // Return the original input in case of not enough parameters
-        throw NoModification();
+        return false;
+    }
+
+    /**
+     *  Modify a value object
+     *  @param  input
+     *  @param  params      Parameters used for this modification
+     *  @return VariantValue
+     *  @throws NoModification  If the input stays the same
+     */
+    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    {
+        // the modified value
+        VariantValue result;
+
+        // the template engine calls apply(), this is for the old interface
+        if (!apply(input, params, result)) throw NoModification();
+
+        // expose the modified value
+        return result;
     }
 };
 
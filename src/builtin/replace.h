@@ -15,7 +15,7 @@ namespace SmartTpl { namespace Internal {
 /**
  *  Class definition
  */
-class ReplaceModifier : public Modifier
+class ReplaceModifier : public StringModifier
 {
 protected:
     /**
@@ -45,28 +45,21 @@ public:
     virtual ~ReplaceModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @return bool        Was the string modified?
      */
-    virtual VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
-        // initialize our output
-        std::string output(input.toString());
-
         // Check if we have at least 2 parameters
-        if (params.size() >= 2)
-        {
-            // If we do use them to execute the replace
-            output = replace(output, params[0].toString(), params[1].toString());
+        if (params.size() < 2) return false;
 
-            // Return the modified output
-            return output;
-        }
+        // If we do use them to execute the replace
+        replace(buffer, params[0].toString(), params[1].toString());
 
-        // Simply return the input
-        throw NoModification();
+        // the string was modified
+        return true;
     }
 };
 
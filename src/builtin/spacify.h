@@ -27,9 +27,10 @@ public:
      *  Modify a value object
      *  @param  input
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @param  result      The modified value
+     *  @return bool        Was the input modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool apply(const Value &input, const SmartTpl::Parameters &params, VariantValue &result) override
     {
         // By default we use one space as a seperator
         std::string seperator(" ");
@@ -61,14 +62,34 @@ public:
             output.erase(output.size() - seperator.size());
 
             // Return the output
-            return output;
+            result = std::move(output);
+            return true;
         }
         catch (...)
         {
             // if we failed we simply return the original input
-            throw NoModification();
+            return false;
         }
     }
+
+    /**
+     *  Modify a value object
+     *  @param  input
+     *  @param  params      Parameters used for this modification
+     *  @return VariantValue
+     *  @throws NoModification  If the input stays the same
+     */
+    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    {
+        // the modified value
+        VariantValue result;
+
+        // the template engine calls apply(), this is for the old interface
+        if (!apply(input, params, result)) throw NoModification();
+
+        // expose the modified value
+        return result;
+    }
 };
 
 /**
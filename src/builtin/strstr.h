@@ -27,9 +27,10 @@ public:
      *  Modify a value object
      *  @param  input
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @param  result      The modified value
+     *  @return bool        Was the input modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool apply(const Value &input, const SmartTpl::Parameters &params, VariantValue &result) override
     {
         if (params.size() >= 1)
         {
@@ -45,14 +46,36 @@ public:
             size_t pos = haystack.find_first_of(needle);
 
             // Return nothing (empty value) if we were unable to find the needle
-            if (pos == std::string::npos) return nullptr;
+            if (pos == std::string::npos) result = nullptr;
+
+            else if (before_needle) result = haystack.substr(0, pos);
+            else result = haystack.substr(pos);
 
-            if (before_needle) return haystack.substr(0, pos);
-            else return haystack.substr(pos);
+            // the input was modified
+            return true;
         }
 
         // Return the input as we can't do strstr without at least a needle
-        throw NoModification();
+        return false;
+    }
+
+    /**
+     *  Modify a value object
+     *  @param  input
+     *  @param  params      Parameters used for this modification
+     *  @return VariantValue
+     *  @throws NoModification  If the input stays the same
+     */
+    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    {
+        // the modified value
+        VariantValue result;
+
+        // the template engine calls apply(), this is for the old interface
+        if (!apply(input, params, result)) throw NoModification();
+
+        // expose the modified value
+        return result;
     }
 };
 
@@ -15,7 +15,7 @@ namespace SmartTpl { namespace Internal {
 /**
  *  Class definition
  */
-class SubStrModifier : public Modifier
+class SubStrModifier : public StringModifier
 {
 public:
     /**
@@ -24,35 +24,32 @@ public:
     virtual ~SubStrModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @return bool        Was the string modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
-        if (params.size() >= 1)
-        {
-            // initialize our output
-            std::string output(input.toString());
-
-            // Turn the second parameter into the substr len parameter
-            size_t len = std::string::npos;
-            if (params.size() >= 2) len = params[1].toNumeric();
-
-            try
-            {
-                // Execute the substr method on output and return the output of it
-                return output.substr(params[0].toNumeric(), len);
-            }
-            catch (const std::out_of_range &error)
-            {
-                // In case this happens just fall through so we end up returning the input
-            }
-        }
-
-        // Return the input as we can't do substr without parameters
-        throw NoModification();
+        // we can't do substr without parameters
+        if (params.size() == 0) return false;
+
+        // the position of the substring
+        size_t pos = params[0].toNumeric();
+
+        // a position after the end of the string is an error, we then keep the input
+        if (pos > buffer.size()) return false;
+
+        // Turn the second parameter into the substr len parameter
+        size_t len = std::string::npos;
+        if (params.size() >= 2) len = params[1].toNumeric();
+
+        // remove the characters after the substring and before it
+        if (len < buffer.size() - pos) buffer.erase(pos + len);
+        buffer.erase(0, pos);
+
+        // the string was modified
+        return true;
     }
 };
 
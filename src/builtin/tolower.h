@@ -15,7 +15,7 @@ namespace SmartTpl { namespace Internal {
 /**
  *  Class definition
  */
-class ToLowerModifier : public Modifier
+class ToLowerModifier : public StringModifier
 {
 public:
     /**
@@ -24,21 +24,18 @@ public:
     virtual ~ToLowerModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @return bool        Was the string modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
-        // copy the entire string
-        std::string output(input.toString());
-
         // convert all the characters to lowercase
-        for (auto & c : output) c = std::tolower(c);
+        for (auto & c : buffer) c = std::tolower(c);
 
-        // return it wrapped into a new StringValue
-        return output;
+        // the string was modified
+        return true;
     }
 };
 
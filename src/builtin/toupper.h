@@ -15,7 +15,7 @@ namespace SmartTpl { namespace Internal {
 /**
  *  Class definition
  */
-class ToUpperModifier : public Modifier {
+class ToUpperModifier : public StringModifier {
 public:
     /**
      *  Destructor
@@ -23,21 +23,18 @@ public:
     virtual ~ToUpperModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Variant
+     *  @return bool        Was the string modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
-        // copy the entire string
-        std::string output(input.toString());
-
         // convert all the characters to uppercase
-        for (auto & c : output) c = std::toupper(c);
+        for (auto & c : buffer) c = std::toupper(c);
 
-        // return it wrapped into a new StringValue
-        return output;
+        // the string was modified
+        return true;
     }
 };
 
@@ -15,7 +15,7 @@ namespace SmartTpl { namespace Internal {
 /**
  *  Class definition
  */
-class TrimModifier : public Modifier
+class TrimModifier : public StringModifier
 {
 public:
     /**
@@ -24,41 +24,38 @@ public:
     virtual ~TrimModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @return bool        Was the string modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
         // initialize our characters to trim
         std::string to_trim(" \t\n\r\0\x0B");
         if (params.size() >= 1) to_trim = params[0].toString();
 
-        // initialize our output
-        std::string output(input.toString());
-
         // First we trim the left side
-        size_t i = output.find_first_not_of(to_trim);
+        size_t i = buffer.find_first_not_of(to_trim);
 
         // If the output of find_first_not_of is 0 it really just means there is nothing to trim at this side
         if (i != 0)
         {
-            if (i != std::string::npos) output.erase(0, i);
-            else output.clear();
+            if (i != std::string::npos) buffer.erase(0, i);
+            else buffer.clear();
         }
 
         // Now let's trim the right side
-        i = output.find_last_not_of(to_trim);
+        i = buffer.find_last_not_of(to_trim);
 
-        if (i + 1 != output.length())
+        if (i + 1 != buffer.length())
         {
-            if (i != std::string::npos) output.erase(i + 1, std::string::npos);
-            else output.clear();
+            if (i != std::string::npos) buffer.erase(i + 1, std::string::npos);
+            else buffer.clear();
         }
 
-        // Return the output
-        return output;
+        // the string was modified
+        return true;
     }
 };
 
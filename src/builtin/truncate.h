@@ -15,7 +15,7 @@ namespace SmartTpl { namespace Internal {
 /**
  *  Class definition
  */
-class TruncateModifier : public Modifier
+class TruncateModifier : public StringModifier
 {
 public:
     /**
@@ -24,12 +24,12 @@ public:
     virtual ~TruncateModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @return bool        Was the string modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
         // init our default settings
         int length = 80;
@@ -43,7 +43,11 @@ public:
             length = params[0].toNumeric();
 
             // If they requested a length of 0 the output will be "" no matter what
-            if (length == 0) return "";
+            if (length == 0)
+            {
+                buffer.clear();
+                return true;
+            }
 
             // Turn the second parameter into the etc field
             if (params.size() >= 2) etc = params[1].toString();
@@ -52,34 +56,29 @@ public:
             if (params.size() >= 3) break_words = params[2].toBoolean();
         }
 
-        // initialize our output
-        std::string output(input.toString());
+        // if our input string is not longer than our requested output we can just keep it like this
+        if (buffer.length() <= length) return true;
 
-        // If our input string is longer than our requested output we need to truncate it
-        if (output.length() > length)
-        {
-            // Reduce the length by the length of etc, or itself whatever is shorter
-            length -= (length < etc.size()) ? length : etc.size();
+        // Reduce the length by the length of etc, or itself whatever is shorter
+        length -= (length < etc.size()) ? length : etc.size();
 
-            if (!break_words)
-            {
-                // As we are not allowed to break words apply some regex magic
-                // just like smarty does
-                // https://code.google.com/p/smarty-php/source/browse/branches/Smarty2Dev/libs/plugins/modifier.truncate.php
-                output = output.substr(0, length + 1);
-                std::ostringstream stream;
-                boost::regex_replace(std::ostream_iterator<char>(stream), output.begin(), output.end(), boost::regex("\\s+?(\\S+)?$"), "");
-                output = stream.str();
-            }
-
-            // Return a substring of length, append etc and return it
-            return output.substr(0, length) + etc;
-        }
-        else
+        if (!break_words)
         {
-            // if it isn't we can just return it like this
-            return output;
+            // As we are not allowed to break words apply some regex magic
+            // just like smarty does
+            // https://code.google.com/p/smarty-php/source/browse/branches/Smarty2Dev/libs/plugins/modifier.truncate.php
+            buffer.resize(length + 1);
+            std::ostringstream stream;
+            boost::regex_replace(std::ostream_iterator<char>(stream), buffer.begin(), buffer.end(), boost::regex("\\s+?(\\S+)?$"), "");
+            buffer = stream.str();
         }
+
+        // Keep a substring of length, and append etc
+        if (buffer.length() > length) buffer.resize(length);
+        buffer.append(etc);
+
+        // the string was modified
+        return true;
     }
 };
 
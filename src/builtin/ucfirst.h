@@ -15,7 +15,7 @@ namespace SmartTpl { namespace Internal {
 /**
  *  Class definition
  */
-class UcFirstModifier : public Modifier
+class UcFirstModifier : public StringModifier
 {
 public:
     /**
@@ -24,26 +24,22 @@ public:
     virtual ~UcFirstModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @return bool        Was the string modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
-        // initialize our output
-        std::string output(input.toString());
-
-        // in case our input is empty we are just returning our input because that
-        // is more efficient than returning this new string. Besides in case of an
-        // empty string calling [0] is undefined behavior..
-        if (output.empty()) throw NoModification();
+        // in case our input is empty we are just returning our input, in case of
+        // an empty string calling [0] is undefined behavior..
+        if (buffer.empty()) return false;
 
         // Turn the first character into the uppercase form
-        output[0] = std::toupper(output[0]);
+        buffer[0] = std::toupper(buffer[0]);
 
-        // Replace the new lines with <br /> and return
-        return output;
+        // the string was modified
+        return true;
     }
 };
 
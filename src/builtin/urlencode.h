@@ -15,7 +15,7 @@ namespace SmartTpl { namespace Internal {
 /**
  *  Class definition
  */
-class UrlencodeModifier : public Modifier
+class UrlencodeModifier : public StringModifier
 {
 public:
     /**
@@ -24,21 +24,18 @@ public:
     virtual ~UrlencodeModifier() {};
 
     /**
-     *  Modify a value object
-     *  @param  input
+     *  Modify a string in place
+     *  @param  buffer      The string to modify
      *  @param  params      Parameters used for this modification
-     *  @return Value
+     *  @return bool        Was the string modified?
      */
-    VariantValue modify(const Value &input, const SmartTpl::Parameters &params) override
+    bool transform(std::string &buffer, const SmartTpl::Parameters &params) override
     {
-        // Get the url encoder
-        const Escaper *escaper = Escaper::get("url");
+        // Call encode on the string
+        Escaper::get("url")->encode(buffer);
 
-        // Turn our input into a string
-        std::string output(input.toString());
-
-        // Call encode and return the output
-        return escaper->encode(output);
+        // the string was modified
+        return true;
     }
 };
 
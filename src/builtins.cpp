@@ -0,0 +1,197 @@
+/**
+ *  Builtins.cpp
+ *
+ *  The process wide table of built-in modifiers
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  The modifier objects, these have no state so one instance is enough
+ */
+static ToUpperModifier         toupper;
+static ToLowerModifier         tolower;
+static CatModifier             cat;
+static CountWordsModifier      count_words;
+static CountCharactersModifier count_characters;
+static CountParagraphsModifier count_paragraphs;
+static DefaultModifier         _default; // Underscore is purely because default is a keyword
+static EscapeModifier          escape;
+static IndentModifier          indent;
+static ReplaceModifier         replace;
+static Nl2brModifier           nl2br;
+static SpacifyModifier         spacify;
+static TruncateModifier        truncate;
+static CountModifier           count;
+static EmptyModifier           empty;
+static StrlenModifier          strlen;
+static UcFirstModifier         ucfirst;
+static TrimModifier            trim;
+static RegexReplaceModifier    regex_replace;
+static SubStrModifier          substr;
+static StrStrModifier          strstr;
+static UrlencodeModifier       urlencode;
+static UrldecodeModifier       urldecode;
+static Md5Modifier             md5;
+static Sha1Modifier            sha1;
+static Sha256Modifier          sha256;
+static Sha512Modifier          sha512;
+static Base64EncodeModifier    base64_encode;
+static Base64DecodeModifier    base64_decode;
+static RangeModifier           range_modifier;
+
+/**
+ *  An entry in the table
+ */
+struct Builtin
+{
+    /**
+     *  Name of the modifier
+     *  @var    const char*
+     */
+    const char *name;
+
+    /**
+     *  Size of the name
+     *  @var    size_t
+     */
+    size_t size;
+
+    /**
+     *  The modifier object
+     *  @var    Modifier*
+     */
+    Modifier *modifier;
+
+    /**
+     *  Does the modifier always produce the same output for the same input,
+     *  without side effects? Such modifiers may be applied in advance
+     *  @var    bool
+     */
+    bool pure;
+
+    /**
+     *  Does the modifier need the openssl library?
+     *  @var    bool
+     */
+    bool openssl;
+};
+
+/**
+ *  All built-in modifiers, sorted by the size of the name first, and by the
+ *  name itself second, so that most comparisons only compare the sizes
+ */
+static const Builtin builtins[] = {
+    {"cat",                3, &cat,              true, false},
+    {"md5",                3, &md5,              true, true},
+    {"sha1",               4, &sha1,             true, true},
+    {"trim",               4, &trim,             true, false},
+    {"count",              5, &count,            true, false},
+    {"empty",              5, &empty,            true, false},
+    {"lower",              5, &tolower,          true, false},
+    {"nl2br",              5, &nl2br,            true, false},
+    {"range",              5, &range_modifier,   true, false},
+    {"upper",              5, &toupper,          true, false},
+    {"escape",             6, &escape,           true, false},
+    {"indent",             6, &indent,           true, false},
+    {"sha256",             6, &sha256,           true, true},
+    {"sha512",             6, &sha512,           true, true},
+    {"strlen",             6, &strlen,           true, false},
+    {"strstr",             6, &strstr,           true, false},
+    {"substr",             6, &substr,           true, false},
+    {"default",            7, &_default,         true, false},
+    {"replace",            7, &replace,          true, false},
+    {"spacify",            7, &spacify,          true, false},
+    {"tolower",            7, &tolower,          true, false},
+    {"toupper",            7, &toupper,          true, false},
+    {"ucfirst",            7, &ucfirst,          true, false},
+    {"truncate",           8, &truncate,         true, false},
+    {"urldecode",          9, &urldecode,        true, false},
+    {"urlencode",          9, &urlencode,        true, false},
+    {"count_words",       11, &count_words,      true, false},
+    {"base64_decode",     13, &base64_decode,    true, true},
+    {"base64_encode",     13, &base64_encode,    true, true},
+    {"regex_replace",     13, &regex_replace,    true, false},
+    {"count_characters",  16, &count_characters, true, false},
+    {"count_paragraphs",  16, &count_paragraphs, true, false},
+};
+
+/**
+ *  Look up an entry in the table
+ *  @param  name        the name of the modifier
+ *  @param  size        size of the name
+ *  @return Builtin*    nullptr if there is no such modifier
+ */
+static const Builtin *lookup(const char *name, size_t size)
+{
+    // binary search in the sorted table
+    auto iter = std::lower_bound(std::begin(builtins), std::end(builtins), size, [name](const Builtin &builtin, size_t size) -> bool {
+        return builtin.size != size ? builtin.size < size : memcmp(builtin.name, name, size) < 0;
+    });
+
+    // check if the modifier was found
+    if (iter == std::end(builtins) || iter->size != size || memcmp(iter->name, name, size) != 0) return nullptr;
+
+    // the modifiers that use openssl are only available if the library could be loaded
+    if (iter->openssl && !OpenSSL::instance()) return nullptr;
+
+    // expose the entry
+    return iter;
+}
+
+/**
+ *  Find a built-in modifier by name
+ *  @param  name        the name of the modifier
+ *  @param  size        size of the name
+ *  @return Modifier*   nullptr if there is no such modifier
+ */
+Modifier *Builtins::find(const char *name, size_t size)
+{
+    // look up the entry
+    auto *builtin = lookup(name, size);
+
+    // expose the modifier
+    return builtin ? builtin->modifier : nullptr;
+}
+
+/**
+ *  Is there a pure built-in modifier with this name?
+ *  @param  name        the name of the modifier
+ *  @param  size        size of the name
+ *  @return bool
+ */
+bool Builtins::pure(const char *name, size_t size)
+{
+    // look up the entry
+    auto *builtin = lookup(name, size);
+
+    // check the flag
+    return builtin && builtin->pure;
+}
+
+/**
+ *  Is a modifier the instance of a pure built-in modifier? The data object
+ *  may have replaced a built-in modifier by one of its own with the same name
+ *  @param  modifier    the modifier to check
+ *  @return bool
+ */
+bool Builtins::pure(const Modifier *modifier)
+{
+    // the table is small, and this is only checked once per loop
+    for (auto &builtin : builtins) if (builtin.modifier == modifier) return builtin.pure;
+
+    // not one of ours
+    return false;
+}
+
+/**
+ *  End namespace
+ */
+}}
@@ -0,0 +1,51 @@
+/**
+ *  Builtins.h
+ *
+ *  Process wide table of the built-in modifiers. The table is a sorted array
+ *  that is part of the library itself, so a data object does not have to
+ *  register these modifiers when it is constructed, and they can safely be
+ *  shared by all threads.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class Builtins
+{
+public:
+    /**
+     *  Find a built-in modifier by name
+     *  @param  name        the name of the modifier
+     *  @param  size        size of the name
+     *  @return Modifier*   nullptr if there is no such modifier
+     */
+    static Modifier *find(const char *name, size_t size);
+
+    /**
+     *  Is there a pure built-in modifier with this name?
+     *  @param  name        the name of the modifier
+     *  @param  size        size of the name
+     *  @return bool
+     */
+    static bool pure(const char *name, size_t size);
+
+    /**
+     *  Is a modifier the instance of a pure built-in modifier?
+     *  @param  modifier    the modifier to check
+     *  @return bool
+     */
+    static bool pure(const Modifier *modifier);
+};
+
+/**
+ *  End namespace
+ */
+}}
@@ -20,10 +20,11 @@ namespace SmartTpl { namespace Internal {
  */
 Bytecode::Bytecode(const Source& source) : 
     _tree(source.version(), source.data(), source.size()),
-    _function_signature(jit_function::signature_helper(jit_type_void, jit_type_void_ptr, jit_function::end_params)),
+    _function_signature(jit_function::signature_helper(jit_type_void, jit_type_void_ptr, jit_type_void_ptr, jit_function::end_params)),
     _function(_context, _function_signature),
     _callbacks(&_function),
     _userdata(_function.get_param(0)),
+    _buffer(_function.get_param(1)),
     _true(_function.new_constant(1)),
     _false(_function.new_constant(0)),
     _error(_function.new_label()),
@@ -105,18 +106,286 @@ jit_value Bytecode::pop()
     return value;
 }
 
+/**
+ *  Generate code to convert a variable to a numeric value
+ *  @param  variable            pointer to the variable
+ *  @return jit_value
+ */
+jit_value Bytecode::toNumeric(const jit_value &variable)
+{
+    // the result, and the labels that we need
+    jit_value result = _function.new_value(jit_type_sys_longlong);
+    jit_label notnumeric = _function.new_label();
+    jit_label custom = _function.new_label();
+    jit_label library = _function.new_label();
+    jit_label done = _function.new_label();
+
+    // load the type tag
+    jit_value type = _function.insn_load_relative(variable, offsetof(smart_tpl_value, type), jit_type_int);
+
+    // null, boolean and numeric values hold the numeric value
+    _function.insn_branch_if(type > _function.new_constant(SMART_TPL_TYPE_NUMERIC, jit_type_int), notnumeric);
+    _function.store(result, _function.insn_load_relative(variable, offsetof(smart_tpl_value, scalar), jit_type_sys_longlong));
+    _function.insn_branch(done);
+
+    // floating point values have to be converted
+    _function.insn_label(notnumeric);
+    _function.insn_branch_if_not(type == _function.new_constant(SMART_TPL_TYPE_DOUBLE, jit_type_int), custom);
+    _function.store(result, _function.insn_convert(_function.insn_load_relative(variable, offsetof(smart_tpl_value, scalar), jit_type_float64), jit_type_sys_longlong));
+    _function.insn_branch(done);
+
+    // typed callbacks of the same type are called directly
+    _function.insn_label(custom);
+    _function.insn_branch_if_not(type == _function.new_constant(SMART_TPL_TYPE_NUMERIC_CALLBACK, jit_type_int), library);
+    jit_value function = _function.insn_load_relative(variable, offsetof(smart_tpl_value, scalar), jit_type_void_ptr);
+    _function.store(result, _callbacks.numeric_callback(function, variable));
+    _function.insn_branch(done);
+
+    // all other values are converted by the library
+    _function.insn_label(library);
+    _function.store(result, _callbacks.to_numeric(_userdata, variable));
+
+    // done
+    _function.insn_label(done);
+    return result;
+}
+
+/**
+ *  Generate code to convert a variable to a boolean value
+ *  @param  variable            pointer to the variable
+ *  @return jit_value
+ */
+jit_value Bytecode::toBoolean(const jit_value &variable)
+{
+    // the result, and the labels that we need
+    jit_value result = _function.new_value(jit_type_sys_bool);
+    jit_label notnumeric = _function.new_label();
+    jit_label custom = _function.new_label();
+    jit_label library = _function.new_label();
+    jit_label done = _function.new_label();
+
+    // load the type tag
+    jit_value type = _function.insn_load_relative(variable, offsetof(smart_tpl_value, type), jit_type_int);
+
+    // null, boolean and numeric values hold the numeric value
+    _function.insn_branch_if(type > _function.new_constant(SMART_TPL_TYPE_NUMERIC, jit_type_int), notnumeric);
+    _function.store(result, _function.insn_to_bool(_function.insn_load_relative(variable, offsetof(smart_tpl_value, scalar), jit_type_sys_longlong)));
+    _function.insn_branch(done);
+
+    // floating point values are true when they are not zero
+    _function.insn_label(notnumeric);
+    _function.insn_branch_if_not(type == _function.new_constant(SMART_TPL_TYPE_DOUBLE, jit_type_int), custom);
+    _function.store(result, _function.insn_load_relative(variable, offsetof(smart_tpl_value, scalar), jit_type_float64) != _function.new_constant(0.0, jit_type_float64));
+    _function.insn_branch(done);
+
+    // typed callbacks of the same type are called directly
+    _function.insn_label(custom);
+    _function.insn_branch_if_not(type == _function.new_constant(SMART_TPL_TYPE_BOOLEAN_CALLBACK, jit_type_int), library);
+    jit_value function = _function.insn_load_relative(variable, offsetof(smart_tpl_value, scalar), jit_type_void_ptr);
+    _function.store(result, _function.insn_to_bool(_callbacks.boolean_callback(function, variable)));
+    _function.insn_branch(done);
+
+    // all other values are converted by the library
+    _function.insn_label(library);
+    _function.store(result, _callbacks.to_boolean(_userdata, variable));
+
+    // done
+    _function.insn_label(done);
+    return result;
+}
+
+/**
+ *  Generate code to convert a variable to a floating point value
+ *  @param  variable            pointer to the variable
+ *  @return jit_value
+ */
+jit_value Bytecode::toDouble(const jit_value &variable)
+{
+    // the result, and the labels that we need
+    jit_value result = _function.new_value(jit_type_float64);
+    jit_label notnumeric = _function.new_label();
+    jit_label custom = _function.new_label();
+    jit_label library = _function.new_label();
+    jit_label done = _function.new_label();
+
+    // load the type tag
+    jit_value type = _function.insn_load_relative(variable, offsetof(smart_tpl_value, type), jit_type_int);
+
+    // null, boolean and numeric values hold a numeric value that has to be converted
+    _function.insn_branch_if(type > _function.new_constant(SMART_TPL_TYPE_NUMERIC, jit_type_int), notnumeric);
+    _function.store(result, _function.insn_convert(_function.insn_load_relative(variable, offsetof(smart_tpl_value, scalar), jit_type_sys_longlong), jit_type_float64));
+    _function.insn_branch(done);
+
+    // floating point values hold the value itself
+    _function.insn_label(notnumeric);
+    _function.insn_branch_if_not(type == _function.new_constant(SMART_TPL_TYPE_DOUBLE, jit_type_int), custom);
+    _function.store(result, _function.insn_load_relative(variable, offsetof(smart_tpl_value, scalar), jit_type_float64));
+    _function.insn_branch(done);
+
+    // typed callbacks of the same type are called directly
+    _function.insn_label(custom);
+    _function.insn_branch_if_not(type == _function.new_constant(SMART_TPL_TYPE_DOUBLE_CALLBACK, jit_type_int), library);
+    jit_value function = _function.insn_load_relative(variable, offsetof(smart_tpl_value, scalar), jit_type_void_ptr);
+    _function.store(result, _callbacks.double_callback(function, variable));
+    _function.insn_branch(done);
+
+    // all other values are converted by the library
+    _function.insn_label(library);
+    _function.store(result, _callbacks.to_double(_userdata, variable));
+
+    // done
+    _function.insn_label(done);
+    return result;
+}
+
+/**
+ *  Generate code to make sure that the output buffer has room for a number of bytes
+ *  @param  size                number of bytes
+ */
+void Bytecode::reserve(const jit_value &size)
+{
+    // label to jump to if there is enough room
+    jit_label done = _function.new_label();
+
+    // load the current write position and the end of the buffer
+    jit_value end = _function.insn_load_relative(_buffer, offsetof(OutputBuffer, end), jit_type_void_ptr);
+    jit_value cap = _function.insn_load_relative(_buffer, offsetof(OutputBuffer, cap), jit_type_void_ptr);
+
+    // in the common case the data fits, and we do not have to call back
+    _function.insn_branch_if(cap - end >= size, done);
+
+    // the buffer is full, let the handler grow it
+    _callbacks.reserve(_userdata, size);
+
+    // this is where we end up when there is enough room
+    _function.insn_label(done);
+}
+
+/**
+ *  Generate code to append data to the output buffer
+ *  @param  data                pointer to the data
+ *  @param  size                size of the data
+ */
+void Bytecode::append(const jit_value &data, const jit_value &size)
+{
+    // make sure there is room in the buffer
+    reserve(size);
+
+    // load the write position (the buffer might have been moved by reserve)
+    jit_value end = _function.insn_load_relative(_buffer, offsetof(OutputBuffer, end), jit_type_void_ptr);
+
+    // copy the data into the buffer
+    _function.insn_memcpy(end, data, size);
+
+    // and update the write position
+    _function.insn_store_relative(_buffer, offsetof(OutputBuffer, end), end + size);
+}
+
+/**
+ *  Generate code to append the decimal representation of a number to the output buffer
+ *  @param  input               the numeric value
+ */
+void Bytecode::appendNumeric(const jit_value &input)
+{
+    // the input could be the result of floating point arithmetic, which is
+    // only written as an integer when it has no fraction
+    if (jit_type_get_kind(input.type()) == JIT_TYPE_FLOAT64)
+    {
+        // labels that we need
+        jit_label integral = _function.new_label();
+        jit_label done = _function.new_label();
+
+        // check if the number survives the conversion to an integer
+        jit_value number = _function.insn_convert(input, jit_type_sys_longlong);
+        _function.insn_branch_if(_function.insn_convert(number, jit_type_float64) == input, integral);
+
+        // numbers with a fraction are formatted by the library
+        _callbacks.output_double(_userdata, input);
+        _function.insn_branch(done);
+
+        // whole numbers are formatted inline
+        _function.insn_label(integral);
+        appendNumeric(number);
+
+        // done
+        _function.insn_label(done);
+        return;
+    }
+
+    // the number that we are going to write
+    jit_value number = input;
+
+    // constants that we need
+    jit_value zero = _function.new_constant((numeric_t)0, jit_type_sys_longlong);
+    jit_value uzero = _function.new_constant((size_t)0, jit_type_sys_ulonglong);
+    jit_value one = _function.new_constant((size_t)1, jit_type_sys_ulonglong);
+    jit_value ten = _function.new_constant((size_t)10, jit_type_sys_ulonglong);
+
+    // the absolute value of the number (as unsigned value, so that even the
+    // lowest negative number can be negated), and the write position
+    jit_value value = _function.new_value(jit_type_sys_ulonglong);
+    jit_value end = _function.new_value(jit_type_void_ptr);
+
+    // store the number
+    _function.store(value, _function.insn_convert(number, jit_type_sys_ulonglong));
+
+    // make sure there is room for the longest possible number
+    reserve(_function.new_constant(OutputBuffer::numericSize, jit_type_sys_ulonglong));
+
+    // load the write position
+    _function.store(end, _function.insn_load_relative(_buffer, offsetof(OutputBuffer, end), jit_type_void_ptr));
+
+    // negative numbers start with a minus sign
+    jit_label positive = _function.new_label();
+    _function.insn_branch_if(number >= zero, positive);
+    _function.insn_store_relative(end, 0, _function.new_constant('-', jit_type_ubyte));
+    _function.store(end, end + one);
+    _function.store(value, uzero - value);
+    _function.insn_label(positive);
+
+    // count the number of digits
+    jit_value digits = _function.new_value(jit_type_sys_ulonglong);
+    jit_value rest = _function.new_value(jit_type_sys_ulonglong);
+    _function.store(digits, one);
+    _function.store(rest, value);
+    jit_label count = _function.new_label();
+    jit_label counted = _function.new_label();
+    _function.insn_label(count);
+    _function.insn_branch_if(rest < ten, counted);
+    _function.store(rest, rest / ten);
+    _function.store(digits, digits + one);
+    _function.insn_branch(count);
+    _function.insn_label(counted);
+
+    // the new write position is right after the last digit
+    jit_value pos = _function.new_value(jit_type_void_ptr);
+    _function.store(pos, end + digits);
+    _function.insn_store_relative(_buffer, offsetof(OutputBuffer, end), pos);
+
+    // write the digits from right to left
+    jit_label next = _function.new_label();
+    _function.insn_label(next);
+    _function.store(pos, pos - one);
+    _function.insn_store_relative(pos, 0, _function.insn_convert(value % ten + _function.new_constant((size_t)'0', jit_type_sys_ulonglong), jit_type_ubyte));
+    _function.store(value, value / ten);
+    _function.insn_branch_if(value != uzero, next);
+}
+
 /**
  *  Generate code to output raw data
  *  @param  data                data to output
  */
 void Bytecode::raw(const std::string &data)
 {
+    // nothing to do for empty data
+    if (data.empty()) return;
+
     // we need a constant of the buffer, and the buffer size
     jit_value buffer = _function.new_constant((void *)data.data(), jit_type_void_ptr);
     jit_value size = _function.new_constant(data.size(), jit_type_sys_ulonglong);
 
-    // call the write function
-    _callbacks.write(_userdata, buffer, size);
+    // copy the data straight into the output buffer
+    append(buffer, size);
 }
 
 /**
@@ -126,6 +395,24 @@ void Bytecode::raw(const std::string &data)
  */
 jit_value Bytecode::pointer(const Variable *variable)
 {
+    // variables that were evaluated before the loop do not have to be looked up again
+    auto iter = _invariants.find(variable);
+    if (iter != _invariants.end()) return iter->second;
+
+    // counters are only turned into a variable when a pointer is needed
+    auto *counter = this->counter(variable);
+    if (counter)
+    {
+        // the name of the variable
+        auto &name = static_cast<const LiteralVariable *>(variable)->name();
+        string(name);
+        auto size = pop();
+        auto buffer = pop();
+
+        // store the current value in the variable
+        return _callbacks.counter(_userdata, buffer, size, *counter);
+    }
+
     // we first have to create a pointer to the variable on the stack
     variable->pointer(this);
 
@@ -181,6 +468,10 @@ jit_value Bytecode::doubleExpression(const Expression *expression)
  */
 void Bytecode::output(const Variable *variable)
 {
+    // counters are written directly into the output buffer
+    auto *counter = this->counter(variable);
+    if (counter) { appendNumeric(*counter); return; }
+
     // output the variable using the output callback, we of course use pointer(Variable*) here
     _callbacks.output(_userdata, pointer(variable), _true);
 }
@@ -191,14 +482,40 @@ void Bytecode::output(const Variable *variable)
  */
 void Bytecode::output(const Filter *filter)
 {
-    // Call the string method on the filter which will call the modifiers() on our generator
-    filter->string(this);
+    // the escape flag for the output callbacks
+    auto escape = filter->escape() ? _true : _false;
+
+    // filters that were evaluated before the loop are written like any other value,
+    // but only if the check before the loop did not leave a null pointer behind
+    jit_label done;
+    auto iter = _invariants.find(filter->modifiers());
+    if (iter != _invariants.end())
+    {
+        // skip to the normal pipeline if the filter was not evaluated
+        jit_label pipeline;
+        _function.insn_branch_if_not(iter->second, pipeline);
 
-    // Pop the value that modifiers() left us
+        // output the value that was evaluated before the loop
+        _callbacks.output(_userdata, iter->second, escape);
+        _function.insn_branch(done);
+
+        // the filter is applied as usual from here on
+        _function.insn_label(pipeline);
+    }
+
+    // apply all modifiers but the last one
+    pipeline(filter->modifiers(), filter->variable());
+
+    // the stack currently contains { parameters, modifier, variable }
+    auto jitparams = pop();
+    auto mod = pop();
     auto var = pop();
 
-    // output this value
-    _callbacks.output(_userdata, var, filter->escape() ? _true : _false);
+    // the last modifier writes straight into the output
+    _callbacks.output_pipeline(_userdata, var, mod, jitparams, escape);
+
+    // this is where the evaluated filter rejoins
+    _function.insn_label(done);
 }
 
 /**
@@ -207,7 +524,8 @@ void Bytecode::output(const Filter *filter)
  */
 void Bytecode::write(const Expression *expression)
 {
-    if (expression->type() == Expression::Type::Numeric) _callbacks.output_numeric(_userdata, numericExpression(expression));
+    // numbers are formatted inline
+    if (expression->type() == Expression::Type::Numeric) appendNumeric(numericExpression(expression));
     else
     {
         // convert the expression to a string (this pushes two values on the stack
@@ -217,8 +535,8 @@ void Bytecode::write(const Expression *expression)
         auto size = pop();
         auto buffer = pop();
 
-        // call the write function
-        _callbacks.write(_userdata, buffer, size);
+        // copy the string into the output buffer
+        append(buffer, size);
     }
 }
 
@@ -330,8 +648,78 @@ void Bytecode::varPointer(const std::string &name)
     jit_value namevalue = _function.new_constant((void *)name.data(), jit_type_void_ptr);
     jit_value namesize = _function.new_constant(name.size(), jit_type_sys_ulonglong);
 
+    // the variables of a loop over a vector are read from the vector itself
+    auto *loop = direct(name);
+    if (!loop) { _stack.push(_callbacks.variable(_userdata, namevalue, namesize)); return; }
+
+    // the pointer, and a label for the variables that are looked up by name
+    auto result = _function.new_value(jit_type_void_ptr);
+    jit_label label_generic = _function.new_label();
+    jit_label label_done = _function.new_label();
+
+    // read the variable from the vector, if the loop iterates over one
+    _function.insn_branch_if_not(loop->vector, label_generic);
+    _function.store(result, element(*loop, name.data(), name.size()));
+    _function.insn_branch(label_done);
+
+    // otherwise look it up by name
+    _function.insn_label(label_generic);
+    _function.store(result, _callbacks.variable(_userdata, namevalue, namesize));
+    _function.insn_label(label_done);
+
     // push the variable on the stack
-    _stack.push(_callbacks.variable(_userdata, namevalue, namesize));
+    _stack.push(result);
+}
+
+/**
+ *  Generate the code to get a pointer to a variable at the end of a path
+ *  @param  parent              parent variable from which the path starts, or nullptr
+ *  @param  path                the path of members
+ *  @note   +1 on the stack
+ */
+void Bytecode::varPointer(const Variable *parent, const Path &path)
+{
+    // the path is owned by the syntax tree, so we can refer to it directly
+    jit_value elements = _function.new_constant((void *)path.elements(), jit_type_void_ptr);
+    jit_value count = _function.new_constant(path.size(), jit_type_sys_ulonglong);
+
+    // paths that start with a name are resolved once, and stored in a slot
+    if (!parent)
+    {
+        // find the slot for the path (identical paths share the slot)
+        auto slot = _slots.emplace(path.key(), _slots.size()).first->second;
+
+        // the variables of a loop over a vector are read from the vector itself
+        auto *first = path.elements();
+        auto *loop = direct(std::string(first->name, first->size));
+
+        // call the native function to resolve the path, or to get it from the slot
+        if (!loop) { _stack.push(_callbacks.slot_path(_userdata, _function.new_constant(slot, jit_type_sys_ulonglong), elements, count)); return; }
+
+        // the pointer, and a label for the paths that are looked up by name
+        auto result = _function.new_value(jit_type_void_ptr);
+        jit_label label_generic = _function.new_label();
+        jit_label label_done = _function.new_label();
+
+        // resolve the rest of the path from the element, if the loop iterates over a vector
+        _function.insn_branch_if_not(loop->vector, label_generic);
+        auto rest = _function.new_constant((void *)(first + 1), jit_type_void_ptr);
+        _function.store(result, _callbacks.path(_userdata, element(*loop, first->name, first->size), rest, _function.new_constant(path.size() - 1, jit_type_sys_ulonglong)));
+        _function.insn_branch(label_done);
+
+        // otherwise resolve the path, or get it from the slot
+        _function.insn_label(label_generic);
+        _function.store(result, _callbacks.slot_path(_userdata, _function.new_constant(slot, jit_type_sys_ulonglong), elements, count));
+        _function.insn_label(label_done);
+
+        // push the variable on the stack
+        _stack.push(result);
+    }
+    else
+    {
+        // call the native function to resolve the entire path at once
+        _stack.push(_callbacks.path(_userdata, pointer(parent), elements, count));
+    }
 }
 
 /**
@@ -390,8 +778,12 @@ void Bytecode::stringVariable(const Variable *variable)
  */
 void Bytecode::numericVariable(const Variable *variable)
 {
-    // call the function to convert a variable to a numeric value
-    _stack.push(_callbacks.to_numeric(_userdata, pointer(variable)));
+    // counters are numeric already
+    auto *counter = this->counter(variable);
+    if (counter) { _stack.push(*counter); return; }
+
+    // convert the variable to a numeric value
+    _stack.push(toNumeric(pointer(variable)));
 }
 
 /**
@@ -401,8 +793,12 @@ void Bytecode::numericVariable(const Variable *variable)
  */
 void Bytecode::booleanVariable(const Variable *variable)
 {
-    // call the function to convert a variable to a numeric value
-    _stack.push(_callbacks.to_boolean(_userdata, pointer(variable)));
+    // counters are true when they are not zero
+    auto *counter = this->counter(variable);
+    if (counter) { _stack.push(_function.insn_to_bool(*counter)); return; }
+
+    // convert the variable to a boolean value
+    _stack.push(toBoolean(pointer(variable)));
 }
 
 /**
@@ -412,8 +808,12 @@ void Bytecode::booleanVariable(const Variable *variable)
  */
 void Bytecode::doubleVariable(const Variable *variable)
 {
-    // call the function to convert a variable to a floating point value
-    _stack.push(_callbacks.to_double(_userdata, pointer(variable)));
+    // counters are converted to a floating point value
+    auto *counter = this->counter(variable);
+    if (counter) { _stack.push(_function.insn_convert(*counter, jit_type_float64)); return; }
+
+    // convert the variable to a floating point value
+    _stack.push(toDouble(pointer(variable)));
 }
 
 void Bytecode::variable(const Variable* variable)
@@ -737,9 +1137,77 @@ void Bytecode::booleanOr(const Expression *left, const Expression *right)
  *  @note   +1 on the stack
  */
 void Bytecode::modifiers(const Modifiers *modifiers, const Variable *variable)
+{
+    // apply the modifiers and push the result to the stack
+    _stack.push(filter(modifiers, variable, false));
+}
+
+/**
+ *  Generate the code to apply a set of modifiers on an expression
+ *  @param  modifiers          The set of modifiers to apply
+ *  @param  variable           The variable to apply the modifiers to
+ *  @param  open               Leave the string of the pipeline open for its consumer
+ *  @return jit_value          The modified value
+ */
+jit_value Bytecode::filter(const Modifiers *modifiers, const Variable *variable, bool open)
+{
+    // filters that were evaluated before the loop do not have to be applied again,
+    // unless the check before the loop left a null pointer behind
+    auto iter = _invariants.find(modifiers);
+    if (iter == _invariants.end()) return apply(modifiers, variable, open);
+
+    // the result is the evaluated filter if there is one
+    jit_value result = _function.new_value(jit_type_void_ptr);
+    _function.store(result, iter->second);
+
+    // otherwise the modifiers are applied as usual
+    jit_label done;
+    _function.insn_branch_if(iter->second, done);
+    _function.store(result, apply(modifiers, variable, open));
+    _function.insn_label(done);
+
+    // done
+    return result;
+}
+
+/**
+ *  Generate the code to apply a set of modifiers on an expression
+ *  @param  modifiers          The set of modifiers to apply
+ *  @param  variable           The variable to apply the modifiers to
+ *  @param  open               Leave the string of the pipeline open for its consumer
+ *  @return jit_value          The modified value
+ */
+jit_value Bytecode::apply(const Modifiers *modifiers, const Variable *variable, bool open)
+{
+    // apply all modifiers but the last one
+    pipeline(modifiers, variable);
+
+    // the stack currently contains { parameters, modifier, variable }
+    auto jitparams = pop();
+    auto mod = pop();
+    auto var = pop();
+
+    // a consumer that is done with the string right away can recycle an open pipeline
+    if (open) return _callbacks.modify_pipeline(_userdata, var, mod, jitparams);
+
+    // let's apply the last modifier
+    return _callbacks.modify_variable(_userdata, var, mod, jitparams);
+}
+
+/**
+ *  Generate the code to apply all modifiers but the last one, and to look
+ *  up the last modifier and its parameters
+ *  @param  modifiers          The set of modifiers to apply
+ *  @param  variable           The variable to apply the modifiers to
+ *  @note   +3 on the stack: the variable, the last modifier and its parameters
+ */
+void Bytecode::pipeline(const Modifiers *modifiers, const Variable *variable)
 {
     // we will need a pointer to the variable on the stack that we can pop off later on to modify it
-    variable->pointer(this);
+    _stack.push(pointer(variable));
+
+    // the number of modifiers that we still have to look up
+    auto remaining = modifiers->size();
 
     // loop through all the modifiers
     for (const auto &modifier : *modifiers)
@@ -756,24 +1224,22 @@ void Bytecode::modifiers(const Modifiers *modifiers, const Variable *variable)
         // call the native function to save the modifier to the variable on the stack
         _stack.push(_callbacks.modifier(_userdata, buffer, size));
 
-        // the stack currently contains { modifier, variable }
-
-        // pop the modifier
-        auto mod = pop();
-
-        // pop the variable from the stack
-        auto var = pop();
-
-        // Let's retrieve our parameters and if we have them generate them
+        // Let's retrieve our parameters and if we have them generate them,
+        // we're using _false here for a nullptr
         const Parameters *params = modifier->parameters();
         if (params) parameters(params);
+        else _stack.push(_false);
+
+        // the last modifier is applied by the caller
+        if (--remaining == 0) return;
 
-        // Turn our possibly just created parameters into a jit_value
-        // We're using _false here for a nullptr
-        jit_value jitparams = (params) ? pop() : _false;
+        // the stack currently contains { parameters, modifier, variable }
+        auto jitparams = pop();
+        auto mod = pop();
+        auto var = pop();
 
-        // let's apply the modifier and push the new result of it to the stack
-        _stack.push(_callbacks.modify_variable(_userdata, var, mod, jitparams));
+        // the result is only passed on to the next modifier, so it may be changed in place
+        _stack.push(_callbacks.modify_pipeline(_userdata, var, mod, jitparams));
     }
 }
 
@@ -784,11 +1250,8 @@ void Bytecode::modifiers(const Modifiers *modifiers, const Variable *variable)
  */
 void Bytecode::modifiersBoolean(const Modifiers *modifiers, const Variable *variable)
 {
-    // first generate the modifiers and all, which adds the output to the stack
-    this->modifiers(modifiers, variable);
-
-    // push the result that is on the stack through to_boolean
-    _stack.push(_callbacks.to_boolean(_userdata, pop()));
+    // the string of the pipeline is left open, the conversion recycles it
+    _stack.push(toBoolean(filter(modifiers, variable, true)));
 }
 
 /**
@@ -801,8 +1264,8 @@ void Bytecode::modifiersDouble(const Modifiers *modifiers, const Variable *varia
     // first generate the modifiers and all, which adds the output to the stack
     this->modifiers(modifiers, variable);
 
-    // push the result that is on the stack through to_double
-    _stack.push(_callbacks.to_double(_userdata, pop()));
+    // convert the result that is on the stack to a floating point value
+    _stack.push(toDouble(pop()));
 }
 
 /**
@@ -863,79 +1326,419 @@ void Bytecode::parameters(const Parameters *parameters)
  */
 void Bytecode::foreach(const Variable *variable, const std::string &key, const std::string &value, const Statements *statements, const Statements *else_statements)
 {
+    // the key and value of a vector are read from the vector itself, unless
+    // they are assigned inside the loop, then they are bound like other variables
+    Invariants assigned("", "");
+    statements->invariants(assigned);
+    bool keys = !key.empty() && !assigned.bound(key);
+    bool elements = !value.empty() && !assigned.bound(value);
+
+    // are there variables left that have to be bound to the elements of a vector?
+    bool binds = (!key.empty() && !keys) || (!value.empty() && !elements);
+
+    // the variable to iterate over
+    auto source = pointer(variable);
+
+    // plain vectors are iterated with an index, other values with an iterator
+    auto vector = _callbacks.vector(_userdata, source);
+
+    // the state of the loop
+    auto iterator = _function.new_value(jit_type_void_ptr);
+    auto index = _function.new_value(jit_type_sys_ulonglong);
+    auto size = _function.new_value(jit_type_sys_ulonglong);
+    auto known = _function.new_value(jit_type_sys_int);
+    auto valid = _function.new_value(jit_type_sys_int);
+    auto data = _function.new_value(jit_type_void_ptr);
+    auto element = _function.new_value(jit_type_void_ptr);
+
+    // constants that we need
+    auto zero = _function.new_constant((size_t)0, jit_type_sys_ulonglong);
+    auto one = _function.new_constant((size_t)1, jit_type_sys_ulonglong);
+    auto null = _function.new_constant((void *)nullptr, jit_type_void_ptr);
+
+    // the elements of a vector are stored one after the other, and they live
+    // in this process, so the distance between them is known
+    auto stride = _function.new_constant(sizeof(VariantValue), jit_type_sys_ulonglong);
+
+    // initialize the state
+    _function.store(iterator, null);
+    _function.store(index, zero);
+    _function.store(size, zero);
+    _function.store(known, _function.new_constant(0, jit_type_sys_int));
+    _function.store(data, null);
+    _function.store(element, null);
+
+    // labels to set up the iterator when the value is not a plain vector
+    jit_label label_iterator = _function.new_label();
+    jit_label label_start = _function.new_label();
+
+    // a plain vector only needs its size
+    _function.insn_branch_if_not(vector, label_iterator);
+    _function.store(size, _callbacks.vector_size(_userdata, vector));
+    _function.store(known, _function.new_constant(1, jit_type_sys_int));
+    if (elements) _function.store(data, _callbacks.vector_data(_userdata, vector));
+    _function.insn_branch(label_start);
+
     // tell the callbacks that we're creating an iterator
-    auto iterator = _callbacks.create_iterator(_userdata, pointer(variable));
+    _function.insn_label(label_iterator);
+    _function.store(iterator, _callbacks.create_iterator(_userdata, source));
+    _function.insn_label(label_start);
+
+    // helper function to construct the name and size of a magic variable, or
+    // a null pointer if the variable is not used
+    auto name = [this](const std::string &name) -> std::pair<jit_value,jit_value> {
 
-    // we create a label just before our loop so we can actually loop
-    // and we create a label just outside of it, so we can jump out of it
+        // pass a null pointer for unused variables
+        if (name.empty()) return std::make_pair(_function.new_constant((void *)nullptr, jit_type_void_ptr), _function.new_constant((size_t)0, jit_type_sys_ulonglong));
+
+        // convert the name into jit values
+        string(name);
+        auto size = pop();
+        auto buffer = pop();
+
+        // done
+        return std::make_pair(buffer, size);
+    };
+
+    // the names of the key and value variables
+    auto key_name = name(key);
+    auto value_name = name(value);
+
+    // the names of the variables that are bound to the elements of a vector,
+    // and of the variables that are read from the vector directly
+    auto none = name(std::string());
+    auto key_bound = keys ? none : key_name;
+    auto value_bound = elements ? none : value_name;
+    auto key_direct = keys ? key_name : none;
+    auto value_direct = elements ? value_name : none;
+
+    // helper function to move to the next element, the key and value are
+    // assigned and 'valid' is set to whether there was an element at all
+    auto fetch = [&]() {
+
+        // labels for the iterator, and for the end of this code
+        jit_label label_generic = _function.new_label();
+        jit_label label_done = _function.new_label();
+
+        // values that are not plain vectors use the iterator
+        _function.insn_branch_if_not(vector, label_generic);
+
+        // assume that we're at the end of the vector
+        _function.store(valid, _function.new_constant(0, jit_type_sys_int));
+        _function.insn_branch_if_not(index < size, label_done);
+
+        // the element is read from the vector directly, unless it has to be
+        // bound to the magic variable like the key, and then we move on
+        if (elements) _function.store(element, data + index * stride);
+        if (binds) _callbacks.vector_bind(_userdata, vector, index, key_bound.first, key_bound.second, value_bound.first, value_bound.second);
+        _function.store(index, index + one);
+        _function.store(valid, _function.new_constant(1, jit_type_sys_int));
+        _function.insn_branch(label_done);
+
+        // the iterator fetches the elements in batches
+        _function.insn_label(label_generic);
+        _function.store(valid, _callbacks.iterator_fetch(_userdata, iterator, key_name.first, key_name.second, value_name.first, value_name.second));
+
+        // the index counts the elements for iterators too
+        _function.store(index, index + one);
+
+        // end of the code
+        _function.insn_label(label_done);
+    };
+
+    // we create a label at the start of the loop body, one just before it to
+    // fetch the next element, one for the else statements, and a label just
+    // outside of it, so we can jump out of it
     jit_label label_while = _function.new_label();
+    jit_label label_body = _function.new_label();
+    jit_label label_else = _function.new_label();
     jit_label label_after_while = _function.new_label();
 
-    if (else_statements)
-    {
-        // Call the valid_iterator callback to begin with
-        auto valid = _callbacks.valid_iterator(_userdata, iterator);
+    // the loop has a single body, the code that moves to the next element
+    // decides at runtime whether it indexes the vector or uses the iterator
+    fetch();
 
-        // Jump to the start of the actual while loop if we are valid
-        _function.insn_branch_if(valid, label_while);
+    // if there is no first element we jump to the else statements
+    _function.insn_branch_if_not(valid, label_else);
 
-        // Otherwise just fall through and call the else_statements
-        else_statements->generate(this);
+    // the loop properties in the body use the state of this loop
+    _loops.push_back({ value, source, index, size, known, key, vector, element, keys, elements });
 
-        // Then just jump over the while loop entirely
-        _function.insn_branch(label_after_while);
-    }
+    // the variables that do not change inside the loop are evaluated once,
+    // before the first iteration
+    auto hoisted = invariants(key, value, statements);
+
+    // jump into the body of the loop
+    _function.insn_branch(label_body);
 
     // we insert our label_while at the start
     _function.insn_label(label_while);
 
-    // make the valid_iterator callback
-    auto valid = _callbacks.valid_iterator(_userdata, iterator);
+    // fetch the next element
+    fetch();
 
-    // if the output of the callback is 0 (false) we jump to label_after_while
+    // if there was no element we jump to label_after_while
     _function.insn_branch_if_not(valid, label_after_while);
 
-    // do we have a key?
-    if (!key.empty())
-    {
-        // construct jit values for the key name
-        string(key);
-        auto key_size = pop();
-        auto key_buf = pop();
+    // the body of the loop
+    _function.insn_label(label_body);
+
+    // generate the actual statements
+    statements->generate(this);
+
+    // jump back to label_while
+    _function.insn_branch(label_while);
+
+    // the evaluated variables and the state can not be used outside the loop
+    for (auto *id : hoisted) _invariants.erase(id);
+    _loops.pop_back();
+
+    // the else statements, in case there was nothing to loop through
+    _function.insn_label(label_else);
+    if (else_statements) else_statements->generate(this);
+
+    // insert our label_after_while at the end
+    _function.insn_label(label_after_while);
+
+    // the variables that were read from the vector keep the last element after the loop
+    if (!keys && !elements) return;
+
+    // only if there was an element at all
+    jit_label label_end = _function.new_label();
+    _function.insn_branch_if_not(vector, label_end);
+    _function.insn_branch_if_not(index, label_end);
+    _callbacks.vector_bind(_userdata, vector, index - one, key_direct.first, key_direct.second, value_direct.first, value_direct.second);
+    _function.insn_label(label_end);
+}
+
+/**
+ *  Generate the code to count from one number to another
+ *  @param name             The magic variable name for the counter
+ *  @param from             The first value of the counter
+ *  @param to               The last value of the counter
+ *  @param step             The value to add after every iteration (nullptr for 1)
+ *  @param statements       The statements to execute on each iteration
+ */
+void Bytecode::count(const std::string &name, const Expression *from, const Expression *to, const Expression *step, const Statements *statements)
+{
+    // the boundaries are evaluated only once
+    auto first = numericExpression(from);
+    auto counter = _function.new_value(jit_type_sys_longlong);
+    _function.store(counter, first);
+    auto last = numericExpression(to);
+    auto increment = step ? numericExpression(step) : _function.new_constant((numeric_t)1, jit_type_sys_longlong);
+
+    // constant that we need
+    auto zero = _function.new_constant((numeric_t)0, jit_type_sys_longlong);
+
+    // labels to check whether the counter is still in range, to count upwards,
+    // to run the body, and to get out of the loop
+    jit_label label_check = _function.new_label();
+    jit_label label_up = _function.new_label();
+    jit_label label_body = _function.new_label();
+    jit_label label_end = _function.new_label();
+
+    // a positive step counts up to the last value, a negative step counts
+    // down to it, and without a step there would be no end at all
+    _function.insn_label(label_check);
+    _function.insn_branch_if(increment > zero, label_up);
+    _function.insn_branch_if_not(increment < zero, label_end);
+    _function.insn_branch_if(counter >= last, label_body);
+    _function.insn_branch(label_end);
+    _function.insn_label(label_up);
+    _function.insn_branch_if_not(counter <= last, label_end);
+
+    // the body of the loop, the variable refers to the counter
+    _function.insn_label(label_body);
+    _counters.emplace_back(name, counter);
+    statements->generate(this);
+    _counters.pop_back();
+
+    // move on to the next value
+    _function.store(counter, counter + increment);
+    _function.insn_branch(label_check);
+
+    // end of the loop
+    _function.insn_label(label_end);
+
+    // like the variables of a foreach loop, the counter keeps its last value
+    // after the loop, if the body was executed at all
+    jit_label label_after = _function.new_label();
+    _function.insn_branch_if(counter == first, label_after);
+    string(name);
+    auto size = pop();
+    auto buffer = pop();
+    _callbacks.counter(_userdata, buffer, size, counter - increment);
+    _function.insn_label(label_after);
+}
 
-        // ask for the key
-        auto current_key = _callbacks.iterator_key(_userdata, iterator);
+/**
+ *  The counter of a for loop that a variable refers to
+ *  @param  variable        The variable
+ *  @return jit_value*      The counter, or nullptr if the variable is not a counter
+ */
+const jit_value *Bytecode::counter(const Variable *variable) const
+{
+    // leap out if we're not inside a for loop
+    if (_counters.empty()) return nullptr;
 
-        // assign the key
-        _callbacks.assign(_userdata, key_buf, key_size, current_key);
+    // only plain variables refer to counters
+    auto *literal = dynamic_cast<const LiteralVariable *>(variable);
+    if (!literal) return nullptr;
+
+    // look for the counter, starting with the innermost loop
+    for (auto iter = _counters.rbegin(); iter != _counters.rend(); ++iter) if (iter->first == literal->name()) return &iter->second;
+
+    // not a counter
+    return nullptr;
+}
+
+/**
+ *  Find the innermost loop with a certain value variable
+ *  @param  name            The magic variable name for the values
+ *  @return Loop
+ *  @throws CompileError    If there is no such loop
+ */
+const Bytecode::Loop &Bytecode::loop(const std::string &name) const
+{
+    // look for the loop, starting with the innermost one
+    for (auto iter = _loops.rbegin(); iter != _loops.rend(); ++iter) if (iter->name == name) return *iter;
+
+    // the property is used outside its loop
+    throw CompileError("Loop property of $" + name + " used outside its foreach loop");
+}
+
+/**
+ *  The loop that reads a variable straight from a vector, if the loop
+ *  iterates over a vector, instead of binding it on every iteration
+ *  @param  name            The name of the variable
+ *  @return const Loop*     The loop, or nullptr if the variable is looked up by name
+ */
+const Bytecode::Loop *Bytecode::direct(const std::string &name) const
+{
+    // look for the loop, starting with the innermost one (a loop only reads
+    // a variable directly if nothing inside the loop binds it again)
+    for (auto iter = _loops.rbegin(); iter != _loops.rend(); ++iter)
+    {
+        // check the key and the value
+        if (iter->keys && iter->key == name) return &*iter;
+        if (iter->elements && iter->name == name) return &*iter;
     }
 
-    // do we have a value?
-    if (!value.empty())
+    // the variable is looked up by name
+    return nullptr;
+}
+
+/**
+ *  Construct the pointer to a variable that a loop reads straight from
+ *  the vector that it iterates over
+ *  @param  loop            The loop
+ *  @param  name            The name of the variable (owned by the syntax tree)
+ *  @param  size            Size of the name
+ *  @return jit_value
+ */
+jit_value Bytecode::element(const Loop &loop, const char *name, size_t size)
+{
+    // the value is the element that the loop is at
+    if (loop.elements && loop.name.compare(0, std::string::npos, name, size) == 0) return loop.element;
+
+    // the key is the position of the element, which is only turned into a variable when a pointer is needed
+    auto position = _function.insn_convert(loop.index - _function.new_constant((size_t)1, jit_type_sys_ulonglong), jit_type_sys_longlong);
+    return _callbacks.counter(_userdata, _function.new_constant((void *)name, jit_type_void_ptr), _function.new_constant(size, jit_type_sys_ulonglong), position);
+}
+
+/**
+ *  Generate the number of the current iteration of a loop (starting at one)
+ *  @param  name            The magic variable name for the values of the loop
+ */
+void Bytecode::loopIteration(const std::string &name)
+{
+    // every fetched element increments the index, so it holds the iteration number
+    _stack.push(_function.insn_convert(loop(name).index, jit_type_sys_longlong));
+}
+
+/**
+ *  Generate the total number of iterations of a loop
+ *  @param  name            The magic variable name for the values of the loop
+ */
+void Bytecode::loopTotal(const std::string &name)
+{
+    // the state of the loop
+    auto &loop = this->loop(name);
+
+    // the size is already known for vectors, and for values of which it was
+    // retrieved before, only the others have to be asked for their members
+    jit_label label_known = _function.new_label();
+    _function.insn_branch_if(loop.known, label_known);
+    _function.store(loop.size, _callbacks.member_count(_userdata, loop.source));
+    _function.store(loop.known, _function.new_constant(1, jit_type_sys_int));
+    _function.insn_label(label_known);
+
+    // push the size as a numeric value
+    _stack.push(_function.insn_convert(loop.size, jit_type_sys_longlong));
+}
+
+/**
+ *  Evaluate the variables inside the body of a loop that do not change
+ *  from one iteration to the next
+ *  @param  key             The magic variable name for the keys
+ *  @param  value           The magic variable name for the values
+ *  @param  statements      The statements that are executed on each iteration
+ *  @return std::vector     Identifiers of the variables that were evaluated
+ */
+std::vector<const void *> Bytecode::invariants(const std::string &key, const std::string &value, const Statements *statements)
+{
+    // find the variables that do not change
+    Invariants invariants(key, value);
+    statements->invariants(invariants);
+
+    // the identifiers that we're going to evaluate
+    std::vector<const void *> result;
+
+    // evaluate all variables
+    for (auto *variable : invariants.variables())
     {
-        // convert our magic key to jit_values for the callback
-        string(value);
-        auto value_size = pop();
-        auto value_buf = pop();
+        // filters are generated through their modifiers, so those identify them
+        auto *filter = dynamic_cast<const Filter *>(variable);
+        const void *id = filter ? (const void *)filter->modifiers() : (const void *)variable;
 
-        // ask for the value
-        auto current_value = _callbacks.iterator_value(_userdata, iterator);
+        // skip variables that were already evaluated before an outer loop
+        if (_invariants.find(id) != _invariants.end()) continue;
 
-        // assign the value
-        _callbacks.assign(_userdata, value_buf, value_size, current_value);
-    }
+        // plain variables can be evaluated right away
+        if (!filter) { _invariants[id] = pointer(variable); result.push_back(id); continue; }
 
-    // generate the actual statements
-    statements->generate(this);
+        // the filter is only evaluated when the data object did not replace any
+        // of its modifiers, a null pointer means that it has to be applied in the loop
+        jit_value hoisted = _function.new_value(jit_type_void_ptr);
+        _function.store(hoisted, _function.new_constant((void *)nullptr, jit_type_void_ptr));
 
-    // proceed with iterator
-    _callbacks.iterator_next(_userdata, iterator);
+        // check the modifiers that are going to be used
+        jit_label skip;
+        for (const auto &modifier : *filter->modifiers())
+        {
+            // look up the modifier by its name
+            string(modifier->token());
+            auto size = pop();
+            auto buffer = pop();
 
-    // jump back to label_while
-    _function.insn_branch(label_while);
+            // skip the evaluation if it is not the built-in modifier
+            _function.insn_branch_if_not(_callbacks.pure_modifier(_userdata, _callbacks.modifier(_userdata, buffer, size)), skip);
+        }
 
-    // insert our label_after_while at the end
-    _function.insn_label(label_after_while);
+        // evaluate the filter
+        _function.store(hoisted, pointer(variable));
+        _function.insn_label(skip);
+
+        // from now on the evaluated filter is used
+        _invariants[id] = hoisted;
+
+        // remember the identifier
+        result.push_back(id);
+    }
+
+    // done
+    return result;
 }
 
 /**
@@ -970,6 +1773,14 @@ void Bytecode::assign(const std::string &key, const Expression *expression)
         break;
     }
     case Expression::Type::Value: {
+        // the string of a filter is left open, the assign callback takes it over
+        const Filter *filter = dynamic_cast<const Filter*>(expression);
+        if (filter)
+        {
+            _callbacks.assign(_userdata, key_str, key_size, this->filter(filter->modifiers(), filter->variable(), true));
+            break;
+        }
+
         const Variable *variable = dynamic_cast<const Variable*>(expression);
         if (variable)
         {
@@ -996,15 +1807,16 @@ void Bytecode::process(Handler &handler)
     if (_closure)
     {
         // call the C function directly
-        _closure(&handler);
+        _closure(&handler, handler.buffer());
     }
     else
     {
-        // the is one argument, a pointer to the handler
+        // there are two arguments, a pointer to the handler and to the output buffer
         void *arg = &handler;
+        void *buffer = handler.buffer();
 
         // arguments should be passed as pointers
-        void *args[1] = { &arg };
+        void *args[2] = { &arg, &buffer };
 
         // call the function
         _function.apply(args, nullptr);
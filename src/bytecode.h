@@ -48,7 +48,7 @@ private:
     /**
      *  Signature of the ShowTemplate function
      */
-    using ShowTemplate = void(const void *userdata);
+    using ShowTemplate = void(const void *userdata, void *buffer);
 
     /**
      *  Jit closure function that is directly callable from C
@@ -68,6 +68,12 @@ private:
      */
     jit_value _userdata;
 
+    /**
+     *  Pointer to the output buffer that is passed to the function
+     *  @var    jit_value
+     */
+    jit_value _buffer;
+
     /**
      *  A jit value constant of 1 which is just here so we can reuse it over and over again
      *  @var    jit_value
@@ -99,6 +105,135 @@ private:
      */
     std::stack<jit_value> _stack;
 
+    /**
+     *  Slots for the paths that start with a variable name, identical paths
+     *  share a slot so that they are resolved only once
+     *  @var    std::map
+     */
+    std::map<std::string, size_t> _slots;
+
+    /**
+     *  Variables that were evaluated before the loop that is being generated,
+     *  because they do not change inside it, indexed by the variable (or by
+     *  the modifiers for filters, because filters are generated through them)
+     *  @var    std::map
+     */
+    std::map<const void *, jit_value> _invariants;
+
+    /**
+     *  The state of a foreach loop that is being generated
+     */
+    struct Loop
+    {
+        /**
+         *  The magic variable name for the values
+         *  @var    std::string
+         */
+        std::string name;
+
+        /**
+         *  The variable that is iterated over
+         *  @var    jit_value
+         */
+        jit_value source;
+
+        /**
+         *  The number of elements that were fetched so far
+         *  @var    jit_value
+         */
+        jit_value index;
+
+        /**
+         *  The number of elements
+         *  @var    jit_value
+         */
+        jit_value size;
+
+        /**
+         *  Is the number of elements known? Zero is also a valid size
+         *  @var    jit_value
+         */
+        jit_value known;
+
+        /**
+         *  The magic variable name for the keys
+         *  @var    std::string
+         */
+        std::string key;
+
+        /**
+         *  The elements of the vector that is iterated over, or a null pointer
+         *  @var    jit_value
+         */
+        jit_value vector;
+
+        /**
+         *  The element of the vector that the loop is at
+         *  @var    jit_value
+         */
+        jit_value element;
+
+        /**
+         *  Is the key of a vector read from the index, instead of being
+         *  bound to the variable on every iteration?
+         *  @var    bool
+         */
+        bool keys;
+
+        /**
+         *  Is the value of a vector read from its elements, instead of being
+         *  bound to the variable on every iteration?
+         *  @var    bool
+         */
+        bool elements;
+    };
+
+    /**
+     *  The loops that are being generated, the innermost loop is at the back
+     *  @var    std::vector
+     */
+    std::vector<Loop> _loops;
+
+    /**
+     *  Find the innermost loop with a certain value variable
+     *  @param  name            The magic variable name for the values
+     *  @return Loop
+     *  @throws CompileError    If there is no such loop
+     */
+    const Loop &loop(const std::string &name) const;
+
+    /**
+     *  The loop that reads a variable straight from a vector, if the loop
+     *  iterates over a vector, instead of binding it on every iteration
+     *  @param  name            The name of the variable
+     *  @return const Loop*     The loop, or nullptr if the variable is looked up by name
+     */
+    const Loop *direct(const std::string &name) const;
+
+    /**
+     *  Construct the pointer to a variable that a loop reads straight from
+     *  the vector that it iterates over
+     *  @param  loop            The loop
+     *  @param  name            The name of the variable (owned by the syntax tree)
+     *  @param  size            Size of the name
+     *  @return jit_value
+     */
+    jit_value element(const Loop &loop, const char *name, size_t size);
+
+    /**
+     *  The counters of the for loops that are being generated, with the
+     *  names of their variables, the innermost loop is at the back
+     *  @var    std::vector
+     */
+    std::vector<std::pair<std::string, jit_value>> _counters;
+
+    /**
+     *  The counter of a for loop that a variable refers to
+     *  @param  variable        The variable
+     *  @return jit_value*      The counter, or nullptr if the variable is not a counter
+     */
+    const jit_value *counter(const Variable *variable) const;
+
     /**
      *  Helper method to pop a value from the stack
      *  @return jit_value
@@ -112,6 +247,44 @@ private:
      */
     jit_value pointer(const Variable *variable);
 
+    /**
+     *  Generate the code to apply all modifiers but the last one, and to look
+     *  up the last modifier and its parameters
+     *  @param  modifiers       The set of modifiers to apply
+     *  @param  variable        The variable to apply the modifiers to
+     *  @note   +3 on the stack: the variable, the last modifier and its parameters
+     */
+    void pipeline(const Modifiers *modifiers, const Variable *variable);
+
+    /**
+     *  Generate the code to apply a set of modifiers on an expression, or to
+     *  use the value that was evaluated before the loop
+     *  @param  modifiers       The set of modifiers to apply
+     *  @param  variable        The variable to apply the modifiers to
+     *  @param  open            Leave the string of the pipeline open for its consumer
+     *  @return jit_value       The modified value
+     */
+    jit_value filter(const Modifiers *modifiers, const Variable *variable, bool open);
+
+    /**
+     *  Generate the code to apply a set of modifiers on an expression
+     *  @param  modifiers       The set of modifiers to apply
+     *  @param  variable        The variable to apply the modifiers to
+     *  @param  open            Leave the string of the pipeline open for its consumer
+     *  @return jit_value       The modified value
+     */
+    jit_value apply(const Modifiers *modifiers, const Variable *variable, bool open);
+
+    /**
+     *  Evaluate the variables inside the body of a loop that do not change
+     *  from one iteration to the next
+     *  @param  key             The magic variable name for the keys
+     *  @param  value           The magic variable name for the values
+     *  @param  statements      The statements that are executed on each iteration
+     *  @return std::vector     Identifiers of the variables that were evaluated
+     */
+    std::vector<const void *> invariants(const std::string &key, const std::string &value, const Statements *statements);
+
     /**
      *  Retrieve the numeric representation of an expression
      *  @param  expression
@@ -133,6 +306,37 @@ private:
      */
     jit_value doubleExpression(const Expression *expression);
 
+    /**
+     *  Generate code to convert a variable to a numeric, boolean or floating
+     *  point value. The scalar is read directly from the value if it holds
+     *  one, and only for other values the conversion callback is called.
+     *  @param  variable            pointer to the variable
+     *  @return jit_value
+     */
+    jit_value toNumeric(const jit_value &variable);
+    jit_value toBoolean(const jit_value &variable);
+    jit_value toDouble(const jit_value &variable);
+
+    /**
+     *  Generate code to make sure that the output buffer has room for a number of bytes
+     *  @param  size                number of bytes
+     */
+    void reserve(const jit_value &size);
+
+    /**
+     *  Generate code to append data to the output buffer
+     *  @param  data                pointer to the data
+     *  @param  size                size of the data
+     */
+    void append(const jit_value &data, const jit_value &size);
+
+    /**
+     *  Generate code to append the decimal representation of a number to the output buffer,
+     *  floating point numbers with a fraction are written by the library
+     *  @param  number              the numeric value
+     */
+    void appendNumeric(const jit_value &number);
+
     /**
      *  Generate code to output raw data
      *  @param  data                data to output
@@ -167,16 +371,19 @@ private:
 
     /**
      *  Generate the code to get a pointer to a variable
-     *  There are three formats, to get a pointer to a literal variable by name,
-     *  to get a pointer to a variable inside a table with a literal name, and
-     *  to get a pointer to a variable with variable name
+     *  There are four formats, to get a pointer to a literal variable by name,
+     *  to get a pointer to a variable inside a table with a literal name, to
+     *  get a pointer to a variable with variable name, and to get a pointer
+     *  to a variable at the end of a path of literal members
      *  @param  parent              parent variable from which the var is retrieved
      *  @param  name                name of the variable
      *  @param  expression          Expression that evaluates to a var name
+     *  @param  path                Path of members (the parent is nullptr if the path starts with a variable name)
      */
     void varPointer(const Variable *parent, const std::string &name) override;
     void varPointer(const Variable *parent, const Expression *expression) override;
     void varPointer(const std::string &name) override;
+    void varPointer(const Variable *parent, const Path &path) override;
 
     /**
      *  Create a string or numeric literal
@@ -270,6 +477,24 @@ private:
      */
     void foreach(const Variable *variable, const std::string &key, const std::string &value, const Statements *statements, const Statements *else_statements) override;
 
+    /**
+     *  Generate the code to count from one number to another
+     *  @param name             The magic variable name for the counter
+     *  @param from             The first value of the counter
+     *  @param to               The last value of the counter
+     *  @param step             The value to add after every iteration (nullptr for 1)
+     *  @param statements       The statements to execute on each iteration
+     */
+    void count(const std::string &name, const Expression *from, const Expression *to, const Expression *step, const Statements *statements) override;
+
+    /**
+     *  Generate the counters of a foreach loop: the number of the current
+     *  iteration (starting at one), and the total number of iterations
+     *  @param  name            The magic variable name for the values of the loop
+     */
+    void loopIteration(const std::string &name) override;
+    void loopTotal(const std::string &name) override;
+
     /**
      *  Generate the code to assign the output of an expression to a key
      *  @param key                  The key to assign the output to
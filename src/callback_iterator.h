@@ -0,0 +1,99 @@
+/**
+ *  Callback_Iterator.h
+ *
+ *  Iterator over the members of a value that was returned by a callback. The
+ *  iterator holds on to the value, so that it stays alive for as long as the
+ *  loop over its members is running.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class CallbackIterator : public SmartTpl::Iterator
+{
+private:
+    /**
+     *  The value returned by the callback
+     *  @var    VariantValue
+     */
+    const VariantValue _value;
+
+    /**
+     *  The iterator over the members of the value
+     *  @var    std::unique_ptr
+     */
+    std::unique_ptr<SmartTpl::Iterator> _iterator;
+
+public:
+    /**
+     *  Constructor
+     *  @param  value       The value returned by the callback
+     */
+    CallbackIterator(VariantValue &&value) :
+        _value(std::move(value)), _iterator(_value.iterator()) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~CallbackIterator() {}
+
+    /**
+     *  Check if the iterator is still valid
+     *  @return bool
+     */
+    bool valid() const override
+    {
+        return _iterator && _iterator->valid();
+    }
+
+    /**
+     *  Move to the next position
+     */
+    void next() override
+    {
+        _iterator->next();
+    }
+
+    /**
+     *  Retrieve pointer to the current member
+     *  @return Variant
+     */
+    VariantValue value() const override
+    {
+        return _iterator->value();
+    }
+
+    /**
+     *  Retrieve a pointer to the current key
+     *  @return Variant
+     */
+    VariantValue key() const override
+    {
+        return _iterator->key();
+    }
+
+    /**
+     *  Fetch a number of elements at once, and move past them
+     *  @param  keys        Array for the keys, or nullptr
+     *  @param  values      Array for the values
+     *  @param  max         Size of the arrays
+     *  @return size_t      Number of elements that were fetched
+     */
+    size_t fetch(VariantValue *keys, VariantValue *values, size_t max) override
+    {
+        return _iterator ? _iterator->fetch(keys, values, max) : 0;
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
@@ -17,8 +17,10 @@ namespace SmartTpl { namespace Internal {
  *  Create all static variables
  */
 SignatureCallback Callbacks::_write({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong });
+SignatureCallback Callbacks::_reserve({ jit_type_void_ptr, jit_type_sys_ulonglong });
 SignatureCallback Callbacks::_output({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong });
 SignatureCallback Callbacks::_output_numeric({ jit_type_void_ptr, jit_type_sys_longlong });
+SignatureCallback Callbacks::_output_double({ jit_type_void_ptr, jit_type_float64 });
 SignatureCallback Callbacks::_member({ jit_type_void_ptr, jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_longlong }, jit_type_void_ptr);
 SignatureCallback Callbacks::_member_at({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong }, jit_type_void_ptr);
 SignatureCallback Callbacks::_create_iterator({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_void_ptr);
@@ -26,14 +28,28 @@ SignatureCallback Callbacks::_valid_iterator({ jit_type_void_ptr, jit_type_void_
 SignatureCallback Callbacks::_iterator_key({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_void_ptr);
 SignatureCallback Callbacks::_iterator_value({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_void_ptr);
 SignatureCallback Callbacks::_iterator_next({ jit_type_void_ptr, jit_type_void_ptr });
+SignatureCallback Callbacks::_vector({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_void_ptr);
+SignatureCallback Callbacks::_vector_size({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_sys_ulonglong);
+SignatureCallback Callbacks::_vector_data({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_void_ptr);
+SignatureCallback Callbacks::_vector_bind({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong, jit_type_void_ptr, jit_type_sys_ulonglong, jit_type_void_ptr, jit_type_sys_ulonglong });
+SignatureCallback Callbacks::_path({ jit_type_void_ptr, jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong }, jit_type_void_ptr);
+SignatureCallback Callbacks::_slot_path({ jit_type_void_ptr, jit_type_sys_ulonglong, jit_type_void_ptr, jit_type_sys_ulonglong }, jit_type_void_ptr);
+SignatureCallback Callbacks::_iterator_fetch({ jit_type_void_ptr, jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong, jit_type_void_ptr, jit_type_sys_ulonglong }, jit_type_sys_int);
 SignatureCallback Callbacks::_variable({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong }, jit_type_void_ptr);
 SignatureCallback Callbacks::_toString({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_void_ptr);
 SignatureCallback Callbacks::_toNumeric({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_sys_longlong);
 SignatureCallback Callbacks::_toDouble({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_float64);
 SignatureCallback Callbacks::_toBoolean({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_sys_bool);
+SignatureCallback Callbacks::_numericCallback({ jit_type_void_ptr }, jit_type_sys_longlong);
+SignatureCallback Callbacks::_booleanCallback({ jit_type_void_ptr }, jit_type_sys_int);
+SignatureCallback Callbacks::_doubleCallback({ jit_type_void_ptr }, jit_type_float64);
 SignatureCallback Callbacks::_size({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_sys_ulonglong);
+SignatureCallback Callbacks::_member_count({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_sys_ulonglong);
 SignatureCallback Callbacks::_modifier({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong }, jit_type_void_ptr);
+SignatureCallback Callbacks::_pure_modifier({ jit_type_void_ptr, jit_type_void_ptr }, jit_type_sys_int);
 SignatureCallback Callbacks::_modify_variable({ jit_type_void_ptr, jit_type_void_ptr, jit_type_void_ptr, jit_type_void_ptr }, jit_type_void_ptr);
+SignatureCallback Callbacks::_modify_pipeline({ jit_type_void_ptr, jit_type_void_ptr, jit_type_void_ptr, jit_type_void_ptr }, jit_type_void_ptr);
+SignatureCallback Callbacks::_output_pipeline({ jit_type_void_ptr, jit_type_void_ptr, jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong });
 SignatureCallback Callbacks::_create_params({ jit_type_void_ptr, jit_type_sys_ulonglong }, jit_type_void_ptr);
 SignatureCallback Callbacks::_params_append_numeric({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_longlong });
 SignatureCallback Callbacks::_params_append_double({ jit_type_void_ptr, jit_type_void_ptr, jit_type_float64 });
@@ -43,15 +59,11 @@ SignatureCallback Callbacks::_strcmp({ jit_type_void_ptr, jit_type_void_ptr, jit
 SignatureCallback Callbacks::_assign({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong, jit_type_void_ptr });
 SignatureCallback Callbacks::_assign_boolean({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong, jit_type_sys_bool });
 SignatureCallback Callbacks::_assign_numeric({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong, jit_type_sys_longlong });
+SignatureCallback Callbacks::_counter({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong, jit_type_sys_longlong }, jit_type_void_ptr);
 SignatureCallback Callbacks::_assign_double({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong, jit_type_float64 });
 SignatureCallback Callbacks::_assign_string({ jit_type_void_ptr, jit_type_void_ptr, jit_type_sys_ulonglong, jit_type_void_ptr, jit_type_sys_ulonglong });
 SignatureCallback Callbacks::_mark_failed({ jit_type_void_ptr, jit_type_void_ptr });
 
-/**
- *  A static empty value
- */
-static VariantValue _empty;
-
 /**
  *  Function to write raw data
  *  @param  userdata        pointer user-supplied data
@@ -67,6 +79,21 @@ void smart_tpl_write(void *userdata, const char *data, size_t size)
     handler->write(data, size);
 }
 
+/**
+ *  Function to make room in the output buffer, the jit compiled code writes
+ *  into the buffer by itself, and only calls this when the buffer is full
+ *  @param  userdata        pointer user-supplied data
+ *  @param  size            number of bytes that should fit in the buffer
+ */
+void smart_tpl_reserve(void *userdata, size_t size)
+{
+    // convert the userdata to a handler object
+    auto *handler = (Handler *)userdata;
+
+    // call the handler
+    handler->reserve(size);
+}
+
 /**
  *  Function to output a variable
  *  @param  userdata        pointer to user-supplied data
@@ -99,6 +126,20 @@ void smart_tpl_output_numeric(void *userdata, numeric_t number)
     handler->outputNumeric(number);
 }
 
+/**
+ *  Function to output a floating point value
+ *  @param  userdata       pointer to user-supplied data
+ *  @param  number         the number to output
+ */
+void smart_tpl_output_double(void *userdata, double number)
+{
+    // Convert the userdata to our handler object
+    auto *handler = (Handler*) userdata;
+
+    // Call the output double method on the handler with our number
+    handler->outputDouble(number);
+}
+
 /**
  *  Retrieve a pointer to a member
  *  @param  userdata        pointer to user-supplied data
@@ -109,21 +150,17 @@ void smart_tpl_output_numeric(void *userdata, numeric_t number)
  */
 const void *smart_tpl_member(void *userdata, const void *variable, const char *name, size_t size)
 {
+    // Give it to our handler so that it stays alive for the rest of the run
+    auto *handler = (Handler *) userdata;
+
     // convert the variable to a variable object
-    auto *var = (const Value *)variable;
+    auto *var = handler->structure((const Value *)variable);
 
     // fetch the member
     auto member = var->member(name, size);
 
-    // Allocate it on the heap so we can return the pointer to it
-    auto *output = new VariantValue(member);
-
-    // Give the pointer to our handler so he can manage the Variant pointer
-    auto *handler = (Handler *) userdata;
-    handler->manageValue(output);
-
-    // return the output
-    return output;
+    // return the managed value (null and booleans are not even allocated)
+    return handler->manage(std::move(member));
 }
 
 /**
@@ -135,21 +172,144 @@ const void *smart_tpl_member(void *userdata, const void *variable, const char *n
  */
 const void* smart_tpl_member_at(void* userdata, const void* variable, size_t position)
 {
+    // Give it to our handler so that it stays alive for the rest of the run
+    auto *handler = (Handler *) userdata;
+
     // convert the variable to a value object
-    auto *var = (const Value *)variable;
+    auto *var = handler->structure((const Value *)variable);
 
     // fetch the member
     auto member = var->member(position);
 
-    // Allocate it on the heap so we can return the pointer to it
-    auto *output = new VariantValue(member);
+    // return the managed value (null and booleans are not even allocated)
+    return handler->manage(std::move(member));
+}
 
-    // Give the pointer to our handler so he can manage the Variant pointer
-    auto *handler = (Handler *) userdata;
-    handler->manageValue(output);
+/**
+ *  Helper function to look up a member inside the vectors and maps of the
+ *  library itself, without copying it
+ *  @param  value           the value to look in
+ *  @param  element         the member to look up
+ *  @return const Value*    the member, or nullptr if the value has no direct access to its members
+ */
+static const Value *lookup(const Value *value, const smart_tpl_path_element &element)
+{
+    // look through the variants
+    while (typeid(*value) == typeid(VariantValue))
+    {
+        // find the wrapped value, inline values have no members at all
+        value = static_cast<const VariantValue *>(value)->wrapped();
+        if (!value) return Immortal::null();
+    }
 
-    // return the output
-    return output;
+    // is this a map?
+    if (typeid(*value) == typeid(MapValue))
+    {
+        // cast to the map
+        auto *map = static_cast<const MapValue *>(value);
+
+        // look up the member by name or by position
+        auto *result = element.name ? map->lookup(element.name, element.size, element.hash) : map->lookup(element.position);
+
+        // members that do not exist are null
+        return result ? result : Immortal::null();
+    }
+
+    // is this a vector?
+    if (typeid(*value) == typeid(VectorValue))
+    {
+        // the elements of the vector
+        auto &elements = static_cast<const VectorValue *>(value)->elements();
+
+        // vectors have no named members
+        if (element.name || element.position >= elements.size()) return Immortal::null();
+
+        // return the element
+        return &elements[element.position];
+    }
+
+    // other values should be asked for their members
+    return nullptr;
+}
+
+/**
+ *  Retrieve a pointer to a variable at the end of a path of members, the
+ *  members of vectors and maps are looked up directly, only the members of
+ *  other values are copied
+ *  @param  userdata        pointer to user-supplied data
+ *  @param  variable        pointer to the variable where the path starts, or nullptr
+ *  @param  path            the members to look up, if variable is nullptr the first one names a variable
+ *  @param  count           number of elements in the path
+ *  @return                 pointer to the variable
+ */
+const void *smart_tpl_path(void *userdata, const void *variable, const struct smart_tpl_path_element *path, size_t count)
+{
+    // cast userdata to our handler
+    auto *handler = (Handler *)userdata;
+
+    // the value where we start
+    auto *value = (const Value *)variable;
+
+    // the path could start with the name of a variable
+    if (!value)
+    {
+        // look up the variable
+        value = handler->variable(path->name, path->size);
+
+        // leap out if it does not exist
+        if (!value) return Immortal::null();
+
+        // skip the name
+        ++path; --count;
+    }
+
+    // callbacks are called only once to look up their members
+    if (count > 0) value = handler->structure(value);
+
+    // walk through the path
+    for (size_t i = 0; i < count; ++i)
+    {
+        // try to look up the member directly
+        auto *member = lookup(value, path[i]);
+
+        // did this work?
+        if (member) { value = member; continue; }
+
+        // ask the value for the member, the result is kept alive by the handler
+        value = handler->manage(path[i].name ? value->member(path[i].name, path[i].size) : value->member(path[i].position));
+    }
+
+    // done
+    return value;
+}
+
+/**
+ *  Retrieve a pointer to a variable at the end of a path that starts with a
+ *  variable name, the path is resolved only once and then stored in a slot
+ *  until one of the local variables that it depends on is assigned
+ *  @param  userdata        pointer to user-supplied data
+ *  @param  slot            the slot of the path
+ *  @param  path            the members to look up, the first one names a variable
+ *  @param  count           number of elements in the path
+ *  @return                 pointer to the variable
+ */
+const void *smart_tpl_slot_path(void *userdata, size_t slot, const struct smart_tpl_path_element *path, size_t count)
+{
+    // cast userdata to our handler
+    auto *handler = (Handler *)userdata;
+
+    // was the path already resolved?
+    auto *result = handler->slot(slot);
+    if (result) return result;
+
+    // resolve the path
+    result = (const Value *)smart_tpl_path(userdata, nullptr, path, count);
+
+    // store it in the slot
+    handler->slot(slot, path->name, result);
+
+    // done
+    return result;
 }
 
 /**
@@ -159,15 +319,15 @@ const void* smart_tpl_member_at(void* userdata, const void* variable, size_t pos
  */
 void *smart_tpl_create_iterator(void *userdata, const void *variable)
 {
+    // cast userdata to our handler
+    auto *handler = (Handler *)userdata;
+
     // cast to actual value object
-    auto *var = (const Value *)variable;
+    auto *var = handler->structure((const Value *)variable);
 
     // construct a new iterator
     auto *iter = new Iterator(var);
 
-    // cast userdata to our handler
-    auto *handler = (Handler *)userdata;
-
     // make our newly allocated iterator managed
     handler->manageIterator(iter);
 
@@ -204,8 +364,11 @@ const void *smart_tpl_iterator_key(void *userdata, void *iterator)
     // Ask the iterator
     auto key = iter->key();
 
-    // Allocate it on the heap so we can return the pointer to it
-    auto *output = new VariantValue(key);
+    // cast userdata to our handler
+    auto *handler = (Handler *)userdata;
+
+    // the handler keeps it alive (null and booleans are not even allocated)
+    auto *output = handler->manage(std::move(key));
 
     // Return the pointer
     return output;
@@ -225,8 +388,11 @@ const void *smart_tpl_iterator_value(void *userdata, void *iterator)
     // fetch the value from the iterator
     auto value = iter->value();
 
-    // Allocate it on the heap so we can return the pointer to it
-    auto *output = new VariantValue(value);
+    // cast userdata to our handler
+    auto *handler = (Handler *)userdata;
+
+    // the handler keeps it alive (null and booleans are not even allocated)
+    auto *output = handler->manage(std::move(value));
 
     // return the output
     return output;
@@ -246,6 +412,135 @@ void smart_tpl_iterator_next(void *userdata, void *iterator)
     iter->next();
 }
 
+/**
+ *  Move the iterator to the next element, and assign its key and value to
+ *  local variables (the first call moves to the first element)
+ *  @param  userdata        pointer to user-supplied data
+ *  @param  iterator        pointer to the iterator returned by smart_tpl_create_iterator
+ *  @param  key             name of the variable for the key, or nullptr
+ *  @param  keysize         size of the key name
+ *  @param  value           name of the variable for the value, or nullptr
+ *  @param  valuesize       size of the value name
+ *  @return                 1 if we moved to the next element, 0 at the end
+ */
+int smart_tpl_iterator_fetch(void *userdata, void *iterator, const char *key, size_t keysize, const char *value, size_t valuesize)
+{
+    // cast to iterator
+    auto *iter = (Iterator *)iterator;
+
+    // move to the next element
+    if (!iter->fetch(key != nullptr)) return 0;
+
+    // cast userdata to our handler
+    auto *handler = (Handler *)userdata;
+
+    // store the key and value in the loop variables, they are only used once so we can move them
+    if (key) handler->step(key, keysize, std::move(iter->fetchedKey()));
+    if (value) handler->step(value, valuesize, std::move(iter->fetchedValue()));
+
+    // we're at a valid element
+    return 1;
+}
+
+/**
+ *  Retrieve the elements of a plain vector value, so that a foreach loop can
+ *  iterate over it with an index instead of an iterator
+ *  @param  userdata        pointer to user-supplied data
+ *  @param  variable        pointer to the variable that is being iterated
+ *  @return                 pointer to the elements, or nullptr if the variable is not a plain vector
+ */
+const void *smart_tpl_vector(void *userdata, const void *variable)
+{
+    // cast userdata to our handler
+    auto *handler = (Handler *)userdata;
+
+    // convert to a value object, callbacks are called to find out what they return
+    auto *value = handler->structure((const Value *)variable);
+
+    // only vectors (and variants that wrap them) have this type
+    if (value->type() != Value::Type::Vector) return nullptr;
+
+    // look through the variants
+    while (typeid(*value) == typeid(VariantValue))
+    {
+        // find the wrapped value
+        value = static_cast<const VariantValue *>(value)->wrapped();
+        if (!value) return nullptr;
+    }
+
+    // classes derived from VectorValue could have their own iterator
+    if (typeid(*value) != typeid(VectorValue)) return nullptr;
+
+    // return the elements, they are bound to the loop variable without being copied
+    return &static_cast<const VectorValue *>(value)->elements();
+}
+
+/**
+ *  Retrieve the number of elements of a vector
+ *  @param  userdata        pointer to user-supplied data
+ *  @param  vector          pointer returned by smart_tpl_vector
+ *  @return                 number of elements
+ */
+size_t smart_tpl_vector_size(void *userdata, const void *vector)
+{
+    // cast to the elements
+    auto *elements = (const std::vector<VariantValue> *)vector;
+
+    // return the size
+    return elements->size();
+}
+
+/**
+ *  Retrieve the first element of a vector, the elements are stored one
+ *  after the other, so that the generated code can index them directly
+ *  @param  userdata        pointer to user-supplied data
+ *  @param  vector          pointer returned by smart_tpl_vector
+ *  @return                 pointer to the first element
+ */
+const void *smart_tpl_vector_data(void *userdata, const void *vector)
+{
+    // cast to the elements
+    auto *elements = (const std::vector<VariantValue> *)vector;
+
+    // the elements are values themselves
+    return static_cast<const Value *>(elements->data());
+}
+
+/**
+ *  Retrieve the distance between two elements of a vector
+ *  @param  userdata        pointer to user-supplied data
+ *  @return                 size of an element
+ */
+size_t smart_tpl_vector_stride(void *userdata)
+{
+    // the elements are variants
+    return sizeof(VariantValue);
+}
+
+/**
+ *  Assign the index and the element of a vector to local variables, the
+ *  element itself is not copied, but bound to the variable
+ *  @param  userdata        pointer to user-supplied data
+ *  @param  vector          pointer returned by smart_tpl_vector
+ *  @param  index           index of the element
+ *  @param  key             name of the variable for the index, or nullptr
+ *  @param  keysize         size of the key name
+ *  @param  value           name of the variable for the element, or nullptr
+ *  @param  valuesize       size of the value name
+ */
+void smart_tpl_vector_bind(void *userdata, const void *vector, size_t index, const char *key, size_t keysize, const char *value, size_t valuesize)
+{
+    // cast to the elements
+    auto *elements = (const std::vector<VariantValue> *)vector;
+
+    // cast userdata to our handler
+    auto *handler = (Handler *)userdata;
+
+    // store the index in the loop variable and bind the element
+    if (key) handler->step(key, keysize, (numeric_t)index);
+    if (value) handler->bind(value, valuesize, elements->data() + index);
+}
+
 /**
  *  Retrieve a pointer to a variable
  *  @param  userdata        pointer to user-supplied data
@@ -262,7 +557,7 @@ const void *smart_tpl_variable(void *userdata, const char *name, size_t size)
     auto *result = handler->variable(name, size);
 
     // ensure that we always return an object
-    return result ? result : &_empty;
+    return result ? result : Immortal::null();
 }
 
 /**
@@ -321,11 +616,21 @@ double smart_tpl_to_double(void *userdata, const void *variable)
  */
 int smart_tpl_to_boolean(void *userdata, const void *variable)
 {
+    // cast userdata to our handler
+    auto *handler = (Handler *)userdata;
+
     // convert the variable to a value object
     auto *var = (const Value *)variable;
 
     // convert to bool
-    return var->toBoolean();
+    bool result = var->toBoolean();
+
+    // the string of an open pipeline is not needed afterwards
+    auto *buffer = handler->pipeline(var);
+    if (buffer) handler->recycle(buffer);
+
+    // done
+    return result;
 }
 
 /**
@@ -346,6 +651,39 @@ size_t smart_tpl_size(void *userdata, const void *variable)
     return handler->manageString(var)->size();
 }
 
+/**
+ *  Retrieve the number of members of a variable that is iterated over by a
+ *  foreach loop, this is only called from inside the loop, so the variable
+ *  has at least one member
+ *  @param  userdata        pointer to user-supplied data
+ *  @param  variable        pointer to variable
+ *  @return                 number of members
+ */
+size_t smart_tpl_member_count(void *userdata, const void *variable)
+{
+    // cast userdata to our handler
+    auto *handler = (Handler *)userdata;
+
+    // convert the variable to a value object
+    auto *var = handler->structure((const Value *)variable);
+
+    // ask the value
+    auto count = var->memberCount();
+    if (count > 0) return count;
+
+    // values that do not know their number of members, like generators and
+    // custom iterators, are counted with an iterator of their own
+    std::unique_ptr<SmartTpl::Iterator> iterator(var->iterator());
+    if (iterator) for (; iterator->valid(); iterator->next()) ++count;
+    if (count > 0) return count;
+
+    // the value can not be iterated over a second time
+    handler->markFailed("The number of iterations of a foreach loop is unknown");
+
+    // nothing to report
+    return 0;
+}
+
 /**
  *  Retrieve the modifier by name
  *  @param userdata       pointer to user-supplied data
@@ -363,7 +701,91 @@ void* smart_tpl_modifier(void *userdata, const char *name, size_t size)
 }
 
 /**
- *  Apply a modifier from smart_tpl_modifier on a value
+ *  Check whether a modifier may be applied in advance, this is only the case
+ *  for the built-in modifiers without side effects, and not for modifiers
+ *  that the data object registered under the same name
+ *  @param  userdata      pointer to user-supplied data
+ *  @param  modifier      pointer to the modifier from smart_tpl_modifier
+ *  @return int
+ */
+int smart_tpl_pure_modifier(void *userdata, const void *modifier)
+{
+    // ask the table of built-in modifiers
+    return Builtins::pure((const Modifier *) modifier) ? 1 : 0;
+}
+
+/**
+ *  The parameters for a modifier
+ *  @param  parameters    pointer to a Parameters object, or a nullptr
+ *  @return SmartTpl::Parameters
+ */
+static const SmartTpl::Parameters &parameters(const void *parameters)
+{
+    // modifiers without parameters all share the same empty object
+    static const SmartTpl::Parameters empty;
+
+    // If parameters is valid use that one, the empty one otherwise
+    return parameters ? *(const SmartTpl::Parameters *) parameters : empty;
+}
+
+/**
+ *  Apply a modifier on a value. Modifiers that work on strings change the
+ *  string of an open pipeline in place, instead of creating a new value
+ *  @param  handler       the handler
+ *  @param  value         the value to apply the modifier on
+ *  @param  modifier      the modifier to apply
+ *  @param  params        the parameters for the modifier
+ *  @param  open          may the next modifier change the result in place?
+ *  @return const Value*
+ */
+static const Value *modify(Handler *handler, const Value *value, Modifier *modifier, const SmartTpl::Parameters &params, bool open)
+{
+    // check if this is a modifier that works on strings
+    auto *strings = dynamic_cast<StringModifier *>(modifier);
+    if (strings)
+    {
+        // the string of an open pipeline can be modified in place
+        auto *buffer = handler->pipeline(value);
+        if (buffer)
+        {
+            // modify the string
+            strings->transform(buffer->buffer(), params);
+
+            // the last modifier of the pipeline closes it
+            if (!open) buffer->close();
+
+            // the buffer is still the result
+            return buffer;
+        }
+
+        // other values are copied into a new buffer
+        std::string work(value->toString());
+
+        // if the string was not modified we return the input again
+        if (!strings->transform(work, params)) return value;
+
+        // give the string to the handler
+        return handler->pipeline(std::move(work), open);
+    }
+
+    // the result of the modification
+    VariantValue variant;
+
+    // if the modifier did not modify the value we just return the input again,
+    // it might be the string of a pipeline that should be closed now
+    if (!modifier->apply(*value, params, variant)) return open ? value : handler->close(value);
+
+    // the result may still refer to the string of an open pipeline, so it
+    // can not be recycled, but it no longer changes
+    handler->close(value);
+
+    // and return the managed value
+    return handler->manage(std::move(variant));
+}
+
+/**
+ *  Apply a modifier from smart_tpl_modifier on a value, this is the last
+ *  modifier that is applied, so the value that is returned no longer changes
  *  @param userdata       pointer to user-supplied data
  *  @param variable       pointer to a value that we should apply the modifier on
  *  @param modifier_ptr   pointer to the modifier that should be applied
@@ -374,40 +796,73 @@ const void* smart_tpl_modify_variable(void *userdata, const void *variable, void
     // In case the modifier or the input is a nullptr just return the original value
     if (modifier_ptr == nullptr || variable == nullptr) return variable;
 
-    // convert to the Modifier
-    auto *modifier = (Modifier *) modifier_ptr;
+    // apply the modifier
+    return modify((Handler *) userdata, (const Value *) variable, (Modifier *) modifier_ptr, SmartTpl::Internal::parameters(parameters), false);
+}
+
+/**
+ *  Apply a modifier from smart_tpl_modifier on a value, when the value that
+ *  is returned is only passed on to the next modifier. Modifiers that work on
+ *  strings may then change it in place
+ *  @param userdata       pointer to user-supplied data
+ *  @param variable       pointer to a value that we should apply the modifier on
+ *  @param modifier_ptr   pointer to the modifier that should be applied
+ *  @param parameters     pointer to a Parameters object
+ */
+const void* smart_tpl_modify_pipeline(void *userdata, const void *variable, void *modifier_ptr, const void *parameters)
+{
+    // In case the modifier or the input is a nullptr just return the original value
+    if (modifier_ptr == nullptr || variable == nullptr) return variable;
+
+    // apply the modifier
+    return modify((Handler *) userdata, (const Value *) variable, (Modifier *) modifier_ptr, SmartTpl::Internal::parameters(parameters), true);
+}
+
+/**
+ *  Apply the last modifier from smart_tpl_modifier on a value, and output the
+ *  result. Modifiers that work on strings write straight into the output
+ *  @param userdata       pointer to user-supplied data
+ *  @param variable       pointer to a value that we should apply the modifier on
+ *  @param modifier_ptr   pointer to the modifier that should be applied
+ *  @param parameters     pointer to a Parameters object
+ *  @param escape         should the output be escaped?
+ */
+void smart_tpl_output_pipeline(void *userdata, const void *variable, void *modifier_ptr, const void *parameters, int escape)
+{
+    // convert the userdata to a handler object
+    auto *handler = (Handler *)userdata;
 
     // convert to a plain old Value*
     auto *value = (const Value *) variable;
 
-    // convert to Parameters object
-    auto *params_ptr = (SmartTpl::Parameters *) parameters;
+    // check if this is a modifier that works on strings
+    auto *strings = dynamic_cast<StringModifier *>((Modifier *) modifier_ptr);
 
-    // If params_ptr is valid use that one, create an empty one on the stack otherwise
-    SmartTpl::Parameters params = (params_ptr) ? *params_ptr : SmartTpl::Parameters();
+    // other modifiers create a value that is written to the output
+    if (!strings || value == nullptr) return handler->output((const Value *) smart_tpl_modify_variable(userdata, variable, modifier_ptr, parameters), escape != 0);
 
-    // the modify method of the modifier could throw a NoModification exception
-    try
+    // the string of an open pipeline is not needed afterwards, so it can be
+    // modified and escaped in place
+    auto *buffer = handler->pipeline(value);
+    if (buffer)
     {
-        // Actually modify the value
-        auto variant = modifier->modify(*value, params);
-
-        // Convert the variant to a pointer so we can actually return it from C
-        auto *output = new VariantValue(variant);
+        // modify the string and close the pipeline
+        strings->transform(buffer->buffer(), SmartTpl::Internal::parameters(parameters));
+        buffer->close();
 
-        // Give it to our handler so he can manage the Variant pointer
-        auto *handler = (Handler *) userdata;
-        handler->manageValue(output);
+        // output the string
+        handler->output(buffer->buffer(), escape != 0);
 
-        // and return the output
-        return output;
-    }
-    catch (const Modifier::NoModification &nomod)
-    {
-        // in case we caught a NoModification exception we know that the intend
-        // was not to modify the input, in which case we just return the input again
-        return value;
+        // the next pipeline can use the buffer
+        return handler->recycle(buffer);
     }
+
+    // other values are copied into a temporary string
+    std::string work(value->toString());
+
+    // modify the string and output it
+    strings->transform(work, SmartTpl::Internal::parameters(parameters));
+    handler->output(work, escape != 0);
 }
 
 /**
@@ -426,6 +881,24 @@ void smart_tpl_assign_numeric(void *userdata, const char *key, size_t keysize, n
     handler->assign(key, keysize, value);
 }
 
+/**
+ *  Turn the counter of a for loop into a variable, the value is stored in
+ *  the same object on every iteration
+ *  @param userdata        pointer to user-supplied data
+ *  @param name            name of the counter variable
+ *  @param size            the size of the name
+ *  @param value           the current value of the counter
+ *  @return                pointer to the variable
+ */
+const void *smart_tpl_counter(void *userdata, const char *name, size_t size, numeric_t value)
+{
+    // Convert userdata to our Handler
+    auto handler = (Handler *) userdata;
+
+    // Store the value in the counter variable
+    return handler->counter(name, size, value);
+}
+
 /**
  *  Assign a floating point value to a local variable
  *  @param userdata        pointer to user-supplied data
@@ -487,11 +960,19 @@ void smart_tpl_assign(void *userdata, const char *key, size_t keysize, const voi
     // Convert userdata to our Handler
     auto handler = (Handler *) userdata;
 
-    // Convert value to type Variant
-    auto *variant = (const VariantValue *) variable;
+    // Convert to a value object
+    auto *value = (const Value *) variable;
 
-    // Assign value to key
-    handler->assign(key, keysize, variant);
+    // the string of an open pipeline is taken over, and the buffer is recycled
+    auto *buffer = handler->pipeline(value);
+    if (buffer)
+    {
+        handler->assign(key, keysize, VariantValue(std::move(buffer->buffer())));
+        return handler->recycle(buffer);
+    }
+
+    // Assign value to key, the value is owned by someone else
+    handler->assign(key, keysize, value);
 }
 
 /**
@@ -18,8 +18,10 @@ namespace SmartTpl { namespace Internal {
  *  Signatures of the global callback functions
  */
 void        smart_tpl_write                 (void *userdata, const char *data, size_t size);
+void        smart_tpl_reserve               (void *userdata, size_t size);
 void        smart_tpl_output                (void *userdata, const void *variable, int escape);
 void        smart_tpl_output_numeric        (void *userdata, numeric_t number);
+void        smart_tpl_output_double         (void *userdata, double number);
 const void *smart_tpl_member                (void *userdata, const void *variable, const char *name, size_t size);
 const void *smart_tpl_member_at             (void *userdata, const void *variable, size_t position);
 void       *smart_tpl_create_iterator       (void *userdata, const void *variable);
@@ -27,15 +29,28 @@ int         smart_tpl_valid_iterator        (void *userdata, void *iterator);
 const void *smart_tpl_iterator_key          (void *userdata, void *iterator);
 const void *smart_tpl_iterator_value        (void *userdata, void *iterator);
 void        smart_tpl_iterator_next         (void *userdata, void *iterator);
+int         smart_tpl_iterator_fetch        (void *userdata, void *iterator, const char *key, size_t keysize, const char *value, size_t valuesize);
+const void *smart_tpl_path                  (void *userdata, const void *variable, const struct smart_tpl_path_element *path, size_t count);
+const void *smart_tpl_slot_path             (void *userdata, size_t slot, const struct smart_tpl_path_element *path, size_t count);
+const void *smart_tpl_vector                (void *userdata, const void *variable);
+size_t      smart_tpl_vector_size           (void *userdata, const void *vector);
+const void *smart_tpl_vector_data           (void *userdata, const void *vector);
+size_t      smart_tpl_vector_stride         (void *userdata);
+void        smart_tpl_vector_bind           (void *userdata, const void *vector, size_t index, const char *key, size_t keysize, const char *value, size_t valuesize);
 const void *smart_tpl_variable              (void *userdata, const char *name, size_t size);
 const char *smart_tpl_to_string             (void *userdata, const void *variable);
 numeric_t   smart_tpl_to_numeric            (void *userdata, const void *variable);
 double      smart_tpl_to_double             (void *userdata, const void *variable);
 int         smart_tpl_to_boolean            (void *userdata, const void *variable);
 size_t      smart_tpl_size                  (void *userdata, const void *variable);
+size_t      smart_tpl_member_count          (void *userdata, const void *variable);
 void       *smart_tpl_modifier              (void *userdata, const char *name, size_t size);
+int         smart_tpl_pure_modifier         (void *userdata, const void *modifier);
 const void *smart_tpl_modify_variable       (void *userdata, const void *variable, void *modifier, const void *parameters);
+const void *smart_tpl_modify_pipeline       (void *userdata, const void *variable, void *modifier, const void *parameters);
+void        smart_tpl_output_pipeline       (void *userdata, const void *variable, void *modifier, const void *parameters, int escape);
 void        smart_tpl_assign_numeric        (void *userdata, const char *key, size_t keysize, numeric_t value);
+const void *smart_tpl_counter               (void *userdata, const char *name, size_t size, numeric_t value);
 void        smart_tpl_assign_boolean        (void *userdata, const char *key, size_t keysize, int boolean);
 void        smart_tpl_assign_string         (void *userdata, const char *key, size_t keysize, const char *buf, size_t buf_size);
 void        smart_tpl_assign_double         (void *userdata, const char *key, size_t keysize, double value);
@@ -66,6 +81,11 @@ private:
      */
     static SignatureCallback _write;
 
+    /**
+     *  Signature of the reserve callback
+     */
+    static SignatureCallback _reserve;
+
     /**
      *  Signature of the output callback
      */
@@ -76,6 +96,11 @@ private:
      */
     static SignatureCallback _output_numeric;
 
+    /**
+     *  Signature fo the output double callback
+     */
+    static SignatureCallback _output_double;
+
     /**
      *  Signature of the member callback
      */
@@ -111,6 +136,35 @@ private:
      */
     static SignatureCallback _iterator_next;
 
+    /**
+     *  Signature of the iterator-fetch callback
+     */
+    static SignatureCallback _iterator_fetch;
+
+    /**
+     *  Signatures of the callbacks to resolve a path of members
+     */
+    static SignatureCallback _path;
+    static SignatureCallback _slot_path;
+
+    /**
+     *  Signatures of the callbacks to iterate over vectors
+     */
+    static SignatureCallback _vector;
+    static SignatureCallback _vector_size;
+    static SignatureCallback _vector_data;
+    static SignatureCallback _vector_bind;
+
+    /**
+     *  Signature of the callback to retrieve the number of members of a looped value
+     */
+    static SignatureCallback _member_count;
+
+    /**
+     *  Signature of the callback that turns the counter of a for loop into a variable
+     */
+    static SignatureCallback _counter;
+
     /**
      *  Signature of the variable callback
      */
@@ -136,6 +190,13 @@ private:
      */
     static SignatureCallback _toBoolean;
 
+    /**
+     *  Signatures of the functions that are stored in the values of typed callbacks
+     */
+    static SignatureCallback _numericCallback;
+    static SignatureCallback _booleanCallback;
+    static SignatureCallback _doubleCallback;
+
     /**
      *  Signature of the function to retrieve the size/strlen of a variable
      */
@@ -146,11 +207,26 @@ private:
      */
     static SignatureCallback _modifier;
 
+    /**
+     *  Signature of the function to check whether a modifier may be applied in advance
+     */
+    static SignatureCallback _pure_modifier;
+
     /**
      *  Signature of the function to modify a variable
      */
     static SignatureCallback _modify_variable;
 
+    /**
+     *  Signature of the function to modify a variable inside a pipeline
+     */
+    static SignatureCallback _modify_pipeline;
+
+    /**
+     *  Signature of the function to modify a variable and to output it
+     */
+    static SignatureCallback _output_pipeline;
+
     /**
      *  Signature of the function to create a new parameters object
      */
@@ -242,6 +318,24 @@ public:
         _function->insn_call_native("smart_tpl_write", (void *)smart_tpl_write, _write.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
     }
 
+    /**
+     *  Call the reserve function, to make room in the output buffer
+     *  @param  userdata        Pointer to user-supplied data
+     *  @param  size            Number of bytes that should fit in the buffer
+     *  @see    smart_tpl_reserve
+     */
+    void reserve(const jit_value &userdata, const jit_value &size)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            size.raw()
+        };
+
+        // create the instruction
+        _function->insn_call_native("smart_tpl_reserve", (void *)smart_tpl_reserve, _reserve.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
     /**
      *  Call the output function
      *  @param  userdata        Pointer to user-supplied data
@@ -280,6 +374,24 @@ public:
         _function->insn_call_native("smart_tpl_output_numeric", (void *)smart_tpl_output_numeric, _output_numeric.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
     }
 
+    /**
+     *  Call the output double function
+     *  @param  userdata        Pointer to user-supplied data
+     *  @param  number          Number to output
+     *  @see    smart_tpl_output_double
+     */
+    void output_double(const jit_value &userdata, const jit_value &number)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            number.raw(),
+        };
+
+        // create the instruction
+        _function->insn_call_native("smart_tpl_output_double", (void *)smart_tpl_output_double, _output_double.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
     /**
      *  Call the member function
      *  @param  userdata        Pointer to user-supplied data
@@ -418,6 +530,183 @@ public:
         _function->insn_call_native("smart_tpl_iterator_next", (void *)smart_tpl_iterator_next, _iterator_next.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
     }
 
+    /**
+     *  Call the iterator_fetch function
+     *  @param  userdata    Pointer to user supplied data
+     *  @param  iterator    Iterator that is in use
+     *  @param  key         Name of the key variable (or a null pointer)
+     *  @param  keysize     Size of the key name
+     *  @param  value       Name of the value variable (or a null pointer)
+     *  @param  valuesize   Size of the value name
+     *  @return jit_value   Did we move to a valid element?
+     *  @see    smart_tpl_iterator_fetch
+     */
+    jit_value iterator_fetch(const jit_value &userdata, const jit_value &iterator, const jit_value &key, const jit_value &keysize, const jit_value &value, const jit_value &valuesize)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            iterator.raw(),
+            key.raw(),
+            keysize.raw(),
+            value.raw(),
+            valuesize.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_native("smart_tpl_iterator_fetch", (void *)smart_tpl_iterator_fetch, _iterator_fetch.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
+    /**
+     *  Call the path function
+     *  @param  userdata    Pointer to user supplied data
+     *  @param  variable    The variable where the path starts (or a null pointer)
+     *  @param  path        Pointer to the elements of the path
+     *  @param  count       Number of elements
+     *  @return jit_value   Pointer to the variable at the end of the path
+     *  @see    smart_tpl_path
+     */
+    jit_value path(const jit_value &userdata, const jit_value &variable, const jit_value &path, const jit_value &count)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            variable.raw(),
+            path.raw(),
+            count.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_native("smart_tpl_path", (void *)smart_tpl_path, _path.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
+    /**
+     *  Call the slot_path function
+     *  @param  userdata    Pointer to user supplied data
+     *  @param  slot        The slot in which the resolved path is stored
+     *  @param  path        Pointer to the elements of the path
+     *  @param  count       Number of elements
+     *  @return jit_value   Pointer to the variable at the end of the path
+     *  @see    smart_tpl_slot_path
+     */
+    jit_value slot_path(const jit_value &userdata, const jit_value &slot, const jit_value &path, const jit_value &count)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            slot.raw(),
+            path.raw(),
+            count.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_native("smart_tpl_slot_path", (void *)smart_tpl_slot_path, _slot_path.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
+    /**
+     *  Call the vector function
+     *  @param  userdata    Pointer to user supplied data
+     *  @param  variable    The variable that is going to be iterated over
+     *  @return jit_value   Pointer to the elements, or a null pointer
+     *  @see    smart_tpl_vector
+     */
+    jit_value vector(const jit_value &userdata, const jit_value &variable)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            variable.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_native("smart_tpl_vector", (void *)smart_tpl_vector, _vector.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
+    /**
+     *  Call the member_count function
+     *  @param  userdata    Pointer to user supplied data
+     *  @param  variable    Pointer to the variable
+     *  @return jit_value   Number of members
+     *  @see    smart_tpl_member_count
+     */
+    jit_value member_count(const jit_value &userdata, const jit_value &variable)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            variable.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_native("smart_tpl_member_count", (void *)smart_tpl_member_count, _member_count.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
+    /**
+     *  Call the vector_size function
+     *  @param  userdata    Pointer to user supplied data
+     *  @param  vector      Pointer returned by the vector function
+     *  @return jit_value   Number of elements
+     *  @see    smart_tpl_vector_size
+     */
+    jit_value vector_size(const jit_value &userdata, const jit_value &vector)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            vector.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_native("smart_tpl_vector_size", (void *)smart_tpl_vector_size, _vector_size.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
+    /**
+     *  Call the vector_data function
+     *  @param  userdata    Pointer to user supplied data
+     *  @param  vector      Pointer returned by the vector function
+     *  @return jit_value   Pointer to the first element
+     *  @see    smart_tpl_vector_data
+     */
+    jit_value vector_data(const jit_value &userdata, const jit_value &vector)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            vector.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_native("smart_tpl_vector_data", (void *)smart_tpl_vector_data, _vector_data.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
+    /**
+     *  Call the vector_bind function
+     *  @param  userdata    Pointer to user supplied data
+     *  @param  vector      Pointer returned by the vector function
+     *  @param  index       Index of the element
+     *  @param  key         Name of the key variable (or a null pointer)
+     *  @param  keysize     Size of the key name
+     *  @param  value       Name of the value variable (or a null pointer)
+     *  @param  valuesize   Size of the value name
+     *  @see    smart_tpl_vector_bind
+     */
+    void vector_bind(const jit_value &userdata, const jit_value &vector, const jit_value &index, const jit_value &key, const jit_value &keysize, const jit_value &value, const jit_value &valuesize)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            vector.raw(),
+            index.raw(),
+            key.raw(),
+            keysize.raw(),
+            value.raw(),
+            valuesize.raw()
+        };
+
+        // create the instruction
+        _function->insn_call_native("smart_tpl_vector_bind", (void *)smart_tpl_vector_bind, _vector_bind.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
     /**
      *  Call the variable function
      *  @param  userdata        Pointer to user-supplied data
@@ -515,6 +804,60 @@ public:
         return _function->insn_call_native("smart_tpl_to_double", (void *)smart_tpl_to_double, _toDouble.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
     }
 
+    /**
+     *  Call the function of a value that is produced by a typed numeric callback
+     *  @param  function        The function that is stored in the value
+     *  @param  variable        Pointer to the variable
+     *  @return jit_value       The scalar
+     *  @see    smart_tpl_value
+     */
+    jit_value numeric_callback(const jit_value &function, const jit_value &variable)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            variable.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_indirect(function, _numericCallback.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
+    /**
+     *  Call the function of a value that is produced by a typed boolean callback
+     *  @param  function        The function that is stored in the value
+     *  @param  variable        Pointer to the variable
+     *  @return jit_value       The scalar
+     *  @see    smart_tpl_value
+     */
+    jit_value boolean_callback(const jit_value &function, const jit_value &variable)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            variable.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_indirect(function, _booleanCallback.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
+    /**
+     *  Call the function of a value that is produced by a typed floating point callback
+     *  @param  function        The function that is stored in the value
+     *  @param  variable        Pointer to the variable
+     *  @return jit_value       The scalar
+     *  @see    smart_tpl_value
+     */
+    jit_value double_callback(const jit_value &function, const jit_value &variable)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            variable.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_indirect(function, _doubleCallback.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
     /**
      *  Call the size function
      *  @param  userdata        Pointer to user-supplied data
@@ -655,6 +998,25 @@ public:
         return _function->insn_call_native("smart_tpl_modifier", (void *)smart_tpl_modifier, _modifier.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
     }
 
+    /**
+     *  Call the function that checks whether a modifier may be applied in advance
+     *  @param  userdata      Pointer to user-supplied data
+     *  @param  modifier      Pointer to the modifier object @see modifier()
+     *  @return jit_value     Boolean value
+     *  @see    smart_tpl_pure_modifier
+     */
+    jit_value pure_modifier(const jit_value &userdata, const jit_value &modifier)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            modifier.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_native("smart_tpl_pure_modifier", (void *)smart_tpl_pure_modifier, _pure_modifier.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
     /**
      *  Call the modify_variable function
      *  @param  userdata    Pointer to user-supplied data
@@ -678,6 +1040,53 @@ public:
         return _function->insn_call_native("smart_tpl_modify_variable", (void *) smart_tpl_modify_variable, _modify_variable.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
     }
 
+    /**
+     *  Call the modify_pipeline function
+     *  @param  userdata    Pointer to user-supplied data
+     *  @param  variable    The variable to modify
+     *  @param  modifier    The modifier to apply @see modifier()
+     *  @param  parameters  The parameters for this modifier
+     *  @return jit_value   A modified variable pointer, that may only be passed to the next modifier
+     *  @see    smart_tpl_modify_pipeline
+     */
+    jit_value modify_pipeline(const jit_value &userdata, const jit_value &variable, const jit_value &modifier, const jit_value &parameters)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            variable.raw(),
+            modifier.raw(),
+            parameters.raw(),
+        };
+
+        // create the instruction
+        return _function->insn_call_native("smart_tpl_modify_pipeline", (void *) smart_tpl_modify_pipeline, _modify_pipeline.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
+    /**
+     *  Call the output_pipeline function
+     *  @param  userdata    Pointer to user-supplied data
+     *  @param  variable    The variable to modify
+     *  @param  modifier    The modifier to apply @see modifier()
+     *  @param  parameters  The parameters for this modifier
+     *  @param  escape      Boolean whether we should escape the output or not
+     *  @see    smart_tpl_output_pipeline
+     */
+    void output_pipeline(const jit_value &userdata, const jit_value &variable, const jit_value &modifier, const jit_value &parameters, const jit_value &escape)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            variable.raw(),
+            modifier.raw(),
+            parameters.raw(),
+            escape.raw(),
+        };
+
+        // create the instruction
+        _function->insn_call_native("smart_tpl_output_pipeline", (void *) smart_tpl_output_pipeline, _output_pipeline.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
     /**
      *  Call the strcmp function
      *  @param  userdata        Pointer to user-supplied data
@@ -725,6 +1134,29 @@ public:
         _function->insn_call_native("smart_tpl_assign", (void *) smart_tpl_assign, _assign.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
     }
 
+    /**
+     *  Call the counter function
+     *  @param  userdata       Pointer to user-supplied data
+     *  @param  name           Name of the counter variable
+     *  @param  size           The length of the name
+     *  @param  value          The current value of the counter
+     *  @return jit_value      Pointer to the variable
+     *  @see    smart_tpl_counter
+     */
+    jit_value counter(const jit_value &userdata, const jit_value &name, const jit_value &size, const jit_value &value)
+    {
+        // construct the arguments
+        jit_value_t args[] = {
+            userdata.raw(),
+            name.raw(),
+            size.raw(),
+            value.raw()
+        };
+
+        // create the instruction
+        return _function->insn_call_native("smart_tpl_counter", (void *) smart_tpl_counter, _counter.signature(), args, sizeof(args)/sizeof(jit_value_t), 0);
+    }
+
     /**
      *  Call the assign_numeric function
      *  @param  userdata       Pointer to user-supplied data
@@ -0,0 +1,75 @@
+/**
+ *  CallbackValue.cpp
+ *
+ *  Access to the members of the value returned by a callback, this is only a
+ *  cpp file because the iterators are internal classes
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Get access to a member value
+ *  @param  name        name of the member
+ *  @param  size        size of the name
+ *  @return VariantValue
+ */
+VariantValue CallbackValue::member(const char *name, size_t size) const
+{
+    // Are we cacheable? Yes return the member of the cached version then
+    if (cache()) return _cache->member(name, size);
+
+    // call the callback to find out the actual value
+    return _callback().member(name, size);
+}
+
+/**
+ *  Get access to the amount of members this value has
+ *  @return size_t
+ */
+size_t CallbackValue::memberCount() const
+{
+    // Are we cacheable? Yes return the cached version then
+    if (cache()) return _cache->memberCount();
+
+    // call the callback to find out the actual value
+    return _callback().memberCount();
+}
+
+/**
+ *  Get access to a member at a certain position
+ *  @param  position    Position of the item we want to retrieve
+ *  @return VariantValue
+ */
+VariantValue CallbackValue::member(size_t position) const
+{
+    // Are we cacheable? Yes return the member of the cached version then
+    if (cache()) return _cache->member(position);
+
+    // call the callback to find out the actual value
+    return _callback().member(position);
+}
+
+/**
+ *  Create a new iterator over the members of the value returned by the callback
+ *  @return Iterator
+ */
+SmartTpl::Iterator *CallbackValue::iterator() const
+{
+    // the cached value stays alive as long as we do
+    if (cache()) return _cache->iterator();
+
+    // the iterator keeps the value alive
+    return new CallbackIterator(_callback());
+}
+
+/**
+ *  End namespace
+ */
+}}
@@ -2,7 +2,8 @@
  *  Callback.h
  *
  *  Specific implementation of the Value class, in which the implementation
- *  is done by a callback
+ *  is done by a callback. The callback may also return a vector or a map,
+ *  the members are then taken from the returned value.
  *
  *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
  *  @copyright 2014 Copernica BV
@@ -38,6 +39,13 @@ private:
      */
     const bool _cacheable;
 
+    /**
+     *  Should the value be cached by the handler for the duration of a
+     *  process call?
+     *  @var    bool
+     */
+    const bool _memoized;
+
     /**
      *  The cached value, will only be used if _cacheable is set to true
      *  @var    std::unique_ptr<VariantValue>
@@ -60,17 +68,56 @@ public:
     /**
      *  Constructor
      *  @param  callback   The callback function
-     *  @param  cache      Should we cache the output of callback or not?
+     *  @param  caching    How long may the output of the callback be cached?
      */
-    CallbackValue(const Callback &callback, bool cache = false)
+    CallbackValue(const Callback &callback, Caching caching = Caching::None)
     : _callback(callback)
-    , _cacheable(cache) {}
+    , _cacheable(caching == Caching::Forever)
+    , _memoized(caching == Caching::Process) {}
 
     /**
      *  Destructor
      */
     virtual ~CallbackValue() {}
 
+    /**
+     *  Is the value of the callback cached forever?
+     *  @return bool
+     */
+    bool cacheable() const
+    {
+        return _cacheable;
+    }
+
+    /**
+     *  Should the value be cached by the handler for the duration of a
+     *  process call?
+     *  @return bool
+     */
+    bool memoized() const
+    {
+        return _memoized;
+    }
+
+    /**
+     *  Call the callback to find out the actual value
+     *  @return VariantValue
+     */
+    VariantValue call() const
+    {
+        return _callback();
+    }
+
+    /**
+     *  The value of the callback, the callback is not called again if its
+     *  value is cached forever
+     *  @return VariantValue
+     */
+    VariantValue value() const
+    {
+        return cache() ? *_cache : _callback();
+    }
+
     /**
      *  Convert the value to a string
      *  @return const char *
@@ -136,50 +183,34 @@ public:
     }
 
     /**
-     *  Get access to a member value
+     *  Get access to a member value, the callback is called to find out the
+     *  value that holds the members
      *
      *  @param  name        name of the member
      *  @param  size        size of the name
      *  @return VariantValue
      */
-    VariantValue member(const char *name, size_t size) const override
-    {
-        // callbacks only return scalar values without members
-        return nullptr;
-    }
+    VariantValue member(const char *name, size_t size) const override;
 
     /**
      *  Get access to the amount of members this value has
+     *  @return size_t
      */
-    size_t memberCount() const override
-    {
-        // callbacks only return scalar variables without members
-        return 0;
-    }
+    size_t memberCount() const override;
 
     /**
      *  Get access to a member at a certain position
      *  @param  position    Position of the item we want to retrieve
      *  @return VariantValue
      */
-    VariantValue member(size_t position) const override
-    {
-        // callbacks can only return scalar values, members will never
-        // be retrieved
-        return nullptr;
-    }
+    VariantValue member(size_t position) const override;
 
     /**
-     *  Create a new iterator that allows you to iterate over the subvalues
-     *  feel free to return nullptr from here in case memberCount returns 0
-     *  as this method won't ever get called in that case anyway.
-     *
+     *  Create a new iterator over the members of the value returned by the
+     *  callback, the iterator keeps that value alive
      *  @return Newly allocated Iterator
      */
-    Iterator *iterator() const override
-    {
-        return nullptr;
-    }
+    SmartTpl::Iterator *iterator() const override;
 };
 
 /**
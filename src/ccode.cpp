@@ -63,17 +63,43 @@ void CCode::raw(const std::string &data)
     _out << "callbacks->write(userdata,\"" << quoted << "\"," << data.size() << ");" << std::endl;
 }
 
+/**
+ *  Generate the pointer to a variable
+ *  @param  variable
+ */
+void CCode::pointer(const Variable *variable)
+{
+    // variables that were evaluated before the loop do not have to be looked up again
+    auto iter = _invariants.find(variable);
+    if (iter != _invariants.end()) { _out << iter->second; return; }
+
+    // counters are only turned into a variable when a pointer is needed
+    auto counter = this->counter(variable);
+    if (!counter.empty())
+    {
+        // store the current value in the variable
+        _out << "callbacks->counter(userdata,"; string(static_cast<const LiteralVariable *>(variable)->name()); _out << ',' << counter << ')';
+    }
+
+    // otherwise the variable generates its own pointer
+    else variable->pointer(this);
+}
+
 /**
  *  Generate the code to output a variable
  *  @param  variable           The variable to output
  */
 void CCode::output(const Variable* variable)
 {
+    // counters are written as numbers
+    auto counter = this->counter(variable);
+    if (!counter.empty()) { _out << "callbacks->output_numeric(userdata," << counter << ");" << std::endl; return; }
+
     // we're going to call the output function
     _out << "callbacks->output(userdata,";
 
     // convert the variable to the pointer of it
-    variable->pointer(this);
+    pointer(variable);
 
     // end of the function
     _out << ",1);" << std::endl;
@@ -85,17 +111,26 @@ void CCode::output(const Variable* variable)
  */
 void CCode::output(const Filter *filter)
 {
-    // Now let's actually call the output callback
-    _out << "callbacks->output(userdata,";
+    // the escape flag for the output callbacks
+    int escape = filter->escape() ? 1 : 0;
 
-    // call the string method on our filter, which writes all the filtering code for us
-    filter->string(this);
+    // filters that were evaluated before the loop are written like any other value,
+    // but only if the check before the loop did not leave a null pointer behind
+    auto iter = _invariants.find(filter->modifiers());
+    if (iter != _invariants.end())
+    {
+        _out << "if (" << iter->second << ") callbacks->output(userdata," << iter->second << ',' << escape << ");" << std::endl;
+        _out << "else ";
+    }
 
-    // Let's write the escape flag
-    _out << ',' << (filter->escape() ? 1 : 0);
+    // the last modifier writes straight into the output
+    _out << "callbacks->output_pipeline(userdata,";
 
-    // And end the output statement
-    _out << ");" << std::endl;
+    // write the rest of the modifiers
+    pipeline(filter->modifiers(), filter->variable());
+
+    // Let's write the escape flag, and end the output statement
+    _out << ',' << escape << ");" << std::endl;
 }
 
 /**
@@ -106,7 +141,8 @@ void CCode::write(const Expression *expression)
 {
     if (expression->type() == Expression::Type::Numeric)
     {
-        _out << "callbacks->output_numeric(userdata,";
+        // the result of arithmetic could be a floating point number
+        _out << "smart_tpl_output_number(callbacks,userdata,";
 
         expression->numeric(this);
 
@@ -169,8 +205,15 @@ void CCode::varPointer(const std::string &name)
     // be picked up by the compiler
     QuotedString quoted(name);
 
+    // the variables of a loop over a vector are read from the vector itself
+    auto *loop = direct(name);
+    if (loop) { _out << "(vector" << loop->suffix << " ? "; element(*loop, name); _out << " : "; }
+
     // call the callback to get the variable
     _out << "callbacks->variable(userdata,\"" << quoted << "\"," << name.size() << ')';
+
+    // end of the conditional expression
+    if (loop) _out << ')';
 }
 
 /**
@@ -184,7 +227,7 @@ void CCode::varPointer(const Variable *parent, const std::string &name)
     _out << "callbacks->member(userdata,";
 
     // generate a var pointer for the variable
-    parent->pointer(this);
+    pointer(parent);
 
     // quote newlines, null characters, etc in the string so that it can
     // be picked up by the compiler
@@ -207,7 +250,7 @@ void CCode::varPointer(const Variable *parent, const Expression *expression)
         _out << "callbacks->member_at(userdata,";
 
         // generate a var pointer for the variable
-        parent->pointer(this);
+        pointer(parent);
         _out << ',';
 
         // generate the expression as a numeric value
@@ -222,7 +265,7 @@ void CCode::varPointer(const Variable *parent, const Expression *expression)
         _out << "callbacks->member(userdata,";
 
         // generate a var pointer for the variable
-        parent->pointer(this);
+        pointer(parent);
 
         // and append a call to retrieve the member
         _out << ',';
@@ -235,6 +278,67 @@ void CCode::varPointer(const Variable *parent, const Expression *expression)
     }
 }
 
+/**
+ *  Generate the code to get a pointer to a variable at the end of a path
+ *  @param  parent              parent variable from which the path starts, or nullptr
+ *  @param  path                the path of members
+ */
+void CCode::varPointer(const Variable *parent, const Path &path)
+{
+    // the elements of the path are passed as a compound literal
+    auto elements = [this, &path](size_t first) {
+
+        // start of the array
+        _out << ",(const struct smart_tpl_path_element[]){";
+
+        // add all elements
+        for (size_t i = first; i < path.size(); ++i)
+        {
+            // the element
+            auto &element = path.elements()[i];
+
+            // separate the elements
+            if (i > first) _out << ',';
+
+            // elements that are accessed by position have no name
+            if (!element.name) { _out << "{0,0,0," << element.position << '}'; continue; }
+
+            // quote newlines, null characters, etc in the name
+            QuotedString quoted(std::string(element.name, element.size));
+
+            // write the name, its size and its hash
+            _out << "{\"" << quoted << "\"," << element.size << ',' << element.hash << "ULL,0}";
+        }
+
+        // end of the call
+        _out << "}," << (path.size() - first) << ')';
+    };
+
+    // paths that start with a name are resolved once, and stored in a slot
+    if (!parent)
+    {
+        // the variables of a loop over a vector are read from the vector itself,
+        // so the rest of the path is resolved from the element
+        std::string name(path.elements()->name, path.elements()->size);
+        auto *loop = direct(name);
+        if (loop) { _out << "(vector" << loop->suffix << " ? callbacks->path(userdata,"; element(*loop, name); elements(1); _out << " : "; }
+
+        // find the slot for the path (identical paths share the slot)
+        auto slot = _slots.emplace(path.key(), _slots.size()).first->second;
+
+        // call the slot_path() function
+        _out << "callbacks->slot_path(userdata," << slot; elements(0);
+
+        // end of the conditional expression
+        if (loop) _out << ')';
+    }
+    else
+    {
+        // call the path() function, with a var pointer for the variable
+        _out << "callbacks->path(userdata,"; pointer(parent); elements(0);
+    }
+}
+
 /**
  *  Create a string literal
  *  @param  value
@@ -288,13 +392,13 @@ void CCode::stringVariable(const Variable *variable)
     _out << "callbacks->to_string(userdata,";
 
     // generate pointer to the variable
-    variable->pointer(this);
+    pointer(variable);
 
     // ask the size of the variable
     _out << "), callbacks->size(userdata,";
 
     // generate another pointer to the variable
-    variable->pointer(this);
+    pointer(variable);
 
     // that was it
     _out << ')';
@@ -306,11 +410,15 @@ void CCode::stringVariable(const Variable *variable)
  */
 void CCode::numericVariable(const Variable *variable)
 {
-    // call the to_numeric method
-    _out << "callbacks->to_numeric(userdata,";
+    // counters are numeric already
+    auto counter = this->counter(variable);
+    if (!counter.empty()) { _out << counter; return; }
+
+    // read the numeric value (directly from scalar values, or else via to_numeric)
+    _out << "smart_tpl_numeric(callbacks,userdata,";
 
     // generate pointer to the variable
-    variable->pointer(this);
+    pointer(variable);
 
     // that was it
     _out << ')';
@@ -322,11 +430,15 @@ void CCode::numericVariable(const Variable *variable)
  */
 void CCode::booleanVariable(const Variable *variable)
 {
-    // call the to_numeric method
-    _out << "callbacks->to_boolean(userdata,";
+    // counters are true when they are not zero
+    auto counter = this->counter(variable);
+    if (!counter.empty()) { _out << '(' << counter << " != 0)"; return; }
+
+    // read the boolean value (directly from scalar values, or else via to_boolean)
+    _out << "smart_tpl_boolean(callbacks,userdata,";
 
     // generate pointer to the variable
-    variable->pointer(this);
+    pointer(variable);
 
     // that was it
     _out << ')';
@@ -338,11 +450,15 @@ void CCode::booleanVariable(const Variable *variable)
  */
 void CCode::doubleVariable(const Variable *variable)
 {
-    // call the to_double method
-    _out << "callbacks->to_double(userdata,";
+    // counters are converted to a floating point value
+    auto counter = this->counter(variable);
+    if (!counter.empty()) { _out << "(double)" << counter; return; }
+
+    // read the floating point value (directly from scalar values, or else via to_double)
+    _out << "smart_tpl_double(callbacks,userdata,";
 
     // generate pointer to the variable
-    variable->pointer(this);
+    pointer(variable);
 
     // that was it
     _out << ')';
@@ -358,7 +474,7 @@ void CCode::variable(const Variable* variable)
     _out << "callbacks->variable(userdata,";
 
     // generate pointer to the variable
-    variable->pointer(this);
+    pointer(variable);
 
     // that was it
     _out << ')';
@@ -609,17 +725,58 @@ void CCode::booleanOr(const Expression *left, const Expression *right)  { left->
  *  @param  expression         The expression to apply to modifiers on
  */
 void CCode::modifiers(const Modifiers *modifiers, const Variable *variable)
+{
+    // the last modifier returns a value that no longer changes
+    filter(modifiers, variable, false);
+}
+
+/**
+ *  Generate the code to apply a set of modifiers on an expression, or to
+ *  use the value that was evaluated before the loop
+ *  @param  modifiers          The set of modifiers to apply
+ *  @param  variable           The variable to apply the modifiers to
+ *  @param  open               Leave the string of the pipeline open for its consumer
+ */
+void CCode::filter(const Modifiers *modifiers, const Variable *variable, bool open)
+{
+    // filters that were evaluated before the loop do not have to be applied again,
+    // unless the check before the loop left a null pointer behind
+    auto iter = _invariants.find(modifiers);
+    if (iter != _invariants.end()) _out << '(' << iter->second << '?' << iter->second << ':';
+
+    // a consumer that is done with the string right away can recycle an open pipeline
+    _out << (open ? "callbacks->modify_pipeline(userdata," : "callbacks->modify_variable(userdata,");
+
+    // write the rest of the modifiers
+    pipeline(modifiers, variable);
+
+    // close the call
+    _out << ')';
+
+    // and the conditional expression
+    if (iter != _invariants.end()) _out << ')';
+}
+
+/**
+ *  Generate the code to apply a set of modifiers, the call to apply the
+ *  last modifier should already have been written, and it is left open so
+ *  that more arguments can be added
+ *  @param  modifiers          The set of modifiers to apply
+ *  @param  variable           The variable to apply the modifiers to
+ */
+void CCode::pipeline(const Modifiers *modifiers, const Variable *variable)
 {
     // get some iterators
     const auto begin = modifiers->begin();
     const auto end = modifiers->end();
     const auto last = --(modifiers->end());
 
-    // write out all the modify_variable calls first
-    for (std::size_t i = 0; i < modifiers->size(); ++i) _out << "callbacks->modify_variable(userdata,";
+    // the results of the other modifiers are only passed on to the next
+    // modifier, so write out their modify_pipeline calls first
+    for (std::size_t i = 1; i < modifiers->size(); ++i) _out << "callbacks->modify_pipeline(userdata,";
 
     // then write the pointer to the variable
-    variable->pointer(this);
+    pointer(variable);
     _out << ',';
 
     // finish writing the actual statements by retrieving all the actual modifiers
@@ -637,10 +794,8 @@ void CCode::modifiers(const Modifiers *modifiers, const Variable *variable)
         // otherwise we generate the parameters inline
         else params->generate(this);
 
-        _out << ')';
-
-        // all of them need this comma, except for the last one
-        if (iter != last) _out << ',';
+        // all of them need to be closed, except for the last one
+        if (iter != last) _out << "),";
     }
 }
 
@@ -652,10 +807,10 @@ void CCode::modifiers(const Modifiers *modifiers, const Variable *variable)
 void CCode::modifiersBoolean(const Modifiers *modifiers, const Variable *variable)
 {
     // write out the to_boolean function
-    _out << "callbacks->to_boolean(userdata,";
+    _out << "smart_tpl_boolean(callbacks,userdata,";
 
-    // write the modifiers, which return a variable pointer
-    this->modifiers(modifiers, variable);
+    // write the modifiers, the string of the pipeline is left open, the conversion recycles it
+    filter(modifiers, variable, true);
 
     // close the function
     _out << ')';
@@ -669,7 +824,7 @@ void CCode::modifiersBoolean(const Modifiers *modifiers, const Variable *variabl
 void CCode::modifiersDouble(const Modifiers *modifiers, const Variable *variable)
 {
     // write the to_double function
-    _out << "callbacks->to_double(userdata,";
+    _out << "smart_tpl_double(callbacks,userdata,";
 
     // write out the modifiers as the variable pointer
     this->modifiers(modifiers, variable);
@@ -755,48 +910,326 @@ void CCode::foreach(const Variable *variable, const std::string &key, const std:
     // a local variable scope
     _out << '{' << std::endl;
 
-    // create the code to create the iterator
-    _out << "void *iterator = callbacks->create_iterator(userdata,";
+    // the names of the local variables
+    auto suffix = this->suffix(_loops.size());
+    auto source = "source" + suffix;
+    auto vector = "vector" + suffix;
+    auto iterator = "iterator" + suffix;
+    auto size = "size" + suffix;
+    auto known = "known" + suffix;
+    auto index = "index" + suffix;
+    auto data = "data" + suffix;
+    auto stride = "stride" + suffix;
+    auto element = "element" + suffix;
+
+    // the key and value of a vector are read from the vector itself, unless
+    // they are assigned inside the loop, then they are bound like other variables
+    Invariants assigned("", "");
+    statements->invariants(assigned);
+    Loop loop = { value, key, suffix, !key.empty() && !assigned.bound(key), !value.empty() && !assigned.bound(value) };
+
+    // are there variables left that have to be bound to the elements of a vector?
+    bool binds = (!key.empty() && !loop.keys) || (!value.empty() && !loop.elements);
 
     // pointer to the variable
-    variable->pointer(this); _out << ");" << std::endl;
-
-    // In case we have else statements write the code to execute them if needed
-    if (else_statements)
+    _out << "const void *" << source << " = "; pointer(variable); _out << ";" << std::endl;
+
+    // plain vectors are iterated with an index, other values with an iterator,
+    // the index counts the elements in both cases
+    _out << "const void *" << vector << " = callbacks->vector(userdata," << source << ");" << std::endl;
+    _out << "void *" << iterator << " = " << vector << " ? 0 : callbacks->create_iterator(userdata," << source << ");" << std::endl;
+    _out << "size_t " << size << " = " << vector << " ? callbacks->vector_size(userdata," << vector << ") : 0;" << std::endl;
+    _out << "int " << known << " = " << vector << " ? 1 : 0;" << std::endl;
+    _out << "size_t " << index << " = 0;" << std::endl;
+
+    // the size of other values is only retrieved when the loop asks for its total
+    _out << "(void)" << known << ';' << std::endl;
+
+    // the elements of a vector are stored one after the other, the body
+    // does not necessarily use the element that the loop is at
+    if (loop.elements)
     {
-        // Check if our iterator is invalid (no data) before the actual loop
-        _out << "if (!callbacks->valid_iterator(userdata,iterator)) {" << std::endl;
+        _out << "const char *" << data << " = " << vector << " ? (const char *)callbacks->vector_data(userdata," << vector << ") : 0;" << std::endl;
+        _out << "const size_t " << stride << " = " << vector << " ? callbacks->vector_stride(userdata) : 0;" << std::endl;
+        _out << "const void *" << element << " = 0;" << std::endl;
+        _out << "(void)" << element << ';' << std::endl;
+    }
 
-        // If it indeed is invalid execute the else statements
-        else_statements->generate(this);
+    // the names of the key and value (a null pointer is passed for unused variables)
+    auto names = [this](const std::string &key, const std::string &value) {
+        if (key.empty()) _out << "0,0"; else string(key);
+        _out << ',';
+        if (value.empty()) _out << "0,0"; else string(value);
+    };
 
-        // Turns out it was valid, guess we'll just loop then
-        _out << "} else {" << std::endl;
-    }
+    // the names of the variables that are bound to the elements of a vector
+    auto bound = [&]() {
+        names(loop.keys ? std::string() : key, loop.elements ? std::string() : value);
+    };
 
-    // construct the loop
-    _out << "while (callbacks->valid_iterator(userdata,iterator)) {" << std::endl;
+    // the code to move to the next element, and to assign the key and value
+    auto fetch = [&]() {
+        _out << '(' << vector << " ? (" << index << " < " << size << " ? (";
+        if (loop.elements) _out << element << " = " << data << " + " << index << " * " << stride << ',';
+        if (binds) { _out << "callbacks->vector_bind(userdata," << vector << ',' << index << ','; bound(); _out << "),"; }
+        _out << "++" << index << ") : 0) : ";
+        _out << "(callbacks->iterator_fetch(userdata," << iterator << ','; names(key, value); _out << ") ? ++" << index << " : 0))";
+    };
 
-    // assign the key and value
-    if (!key.empty()) { _out << "callbacks->assign(userdata,"; string(key); _out << ",callbacks->iterator_key(userdata,iterator));" << std::endl; }
-    if (!value.empty()) { _out << "callbacks->assign(userdata,"; string(value); _out << ",callbacks->iterator_value(userdata,iterator));" << std::endl; }
+    // only enter the loop if there is a first element
+    _out << "if ("; fetch(); _out << ") {" << std::endl;
+
+    // the loop properties and variables in the body use the state of this loop
+    _loops.push_back(loop);
+
+    // evaluate the values that do not change inside the loop
+    auto hoisted = invariants(key, value, statements);
+
+    // construct the loop
+    _out << "do {" << std::endl;
 
     // generate the actual statements
     statements->generate(this);
 
     // proceed the iterator
-    _out << "callbacks->iterator_next(userdata,iterator);" << std::endl;
+    _out << "} while ("; fetch(); _out << ");" << std::endl;
+
+    // the evaluated values and the state are out of scope after the loop
+    for (auto *id : hoisted) _invariants.erase(id);
+    _loops.pop_back();
+
+    // the variables that were read from the vector keep the last element after the loop
+    if (loop.keys || loop.elements)
+    {
+        _out << "if (" << vector << ") callbacks->vector_bind(userdata," << vector << ',' << index << " - 1,";
+        names(loop.keys ? key : std::string(), loop.elements ? value : std::string());
+        _out << ");" << std::endl;
+    }
+
+    // In case we have else statements they are executed if there was no first element
+    if (else_statements)
+    {
+        // the else block
+        _out << "} else {" << std::endl;
+
+        // execute the else statements
+        else_statements->generate(this);
+    }
+
+    // end of the if statement
+    _out << '}' << std::endl;
+
+    // end of the block
+    _out << '}' << std::endl;
+}
+
+/**
+ *  Generate the code to count from one number to another
+ *  @param name             The magic variable name for the counter
+ *  @param from             The first value of the counter
+ *  @param to               The last value of the counter
+ *  @param step             The value to add after every iteration (nullptr for 1)
+ *  @param statements       The statements to execute on each iteration
+ */
+void CCode::count(const std::string &name, const Expression *from, const Expression *to, const Expression *step, const Statements *statements)
+{
+    // the names of the local variables
+    auto suffix = std::to_string(_counters.size());
+    auto counter = "counter" + suffix;
+    auto first = "first" + suffix;
+    auto last = "last" + suffix;
+    auto increment = "step" + suffix;
+
+    // the loop is implemented inside a seperate block to create a local variable scope
+    _out << '{' << std::endl;
+
+    // the boundaries are evaluated only once
+    _out << "const numeric_t " << first << " = "; from->numeric(this); _out << ';' << std::endl;
+    _out << "numeric_t " << counter << " = " << first << ';' << std::endl;
+    _out << "const numeric_t " << last << " = "; to->numeric(this); _out << ';' << std::endl;
+    _out << "const numeric_t " << increment << " = "; if (step) step->numeric(this); else _out << '1'; _out << ';' << std::endl;
+
+    // a positive step counts up to the last value, a negative step counts
+    // down to it, and without a step there would be no end at all
+    _out << "for (; " << increment << " > 0 ? " << counter << " <= " << last << " : " << increment << " < 0 && " << counter << " >= " << last << "; " << counter << " += " << increment << ") {" << std::endl;
+
+    // the body of the loop, the variable refers to the counter
+    _counters.push_back(name);
+    statements->generate(this);
+    _counters.pop_back();
 
-    // end of the while loop
+    // end of the loop
     _out << '}' << std::endl;
 
-    // End our else block if we have an else block that is
-    if (else_statements) _out << '}' << std::endl;
+    // like the variables of a foreach loop, the counter keeps its last value
+    // after the loop, if the body was executed at all
+    _out << "if (" << counter << " != " << first << ") callbacks->counter(userdata,"; string(name); _out << ',' << counter << " - " << increment << ");" << std::endl;
 
     // end of the block
     _out << '}' << std::endl;
 }
 
+/**
+ *  The local variable that holds the counter of a for loop that a
+ *  variable refers to
+ *  @param  variable        The variable
+ *  @return std::string     Name of the local variable, or empty if the variable is not a counter
+ */
+std::string CCode::counter(const Variable *variable) const
+{
+    // leap out if we're not inside a for loop
+    if (_counters.empty()) return std::string();
+
+    // only plain variables refer to counters
+    auto *literal = dynamic_cast<const LiteralVariable *>(variable);
+    if (!literal) return std::string();
+
+    // look for the counter, starting with the innermost loop
+    for (size_t depth = _counters.size(); depth > 0; --depth) if (_counters[depth - 1] == literal->name()) return "counter" + std::to_string(depth - 1);
+
+    // not a counter
+    return std::string();
+}
+
+/**
+ *  The loop that reads a variable straight from a vector, if the loop
+ *  iterates over a vector, instead of binding it on every iteration
+ *  @param  name            The name of the variable
+ *  @return const Loop*     The loop, or nullptr if the variable is looked up by name
+ */
+const CCode::Loop *CCode::direct(const std::string &name) const
+{
+    // look for the loop, starting with the innermost one (a loop only reads
+    // a variable directly if nothing inside the loop binds it again)
+    for (auto iter = _loops.rbegin(); iter != _loops.rend(); ++iter)
+    {
+        // check the key and the value
+        if (iter->keys && iter->key == name) return &*iter;
+        if (iter->elements && iter->name == name) return &*iter;
+    }
+
+    // the variable is looked up by name
+    return nullptr;
+}
+
+/**
+ *  Generate the pointer to a variable that a loop reads straight from
+ *  the vector that it iterates over
+ *  @param  loop            The loop
+ *  @param  name            The name of the variable
+ */
+void CCode::element(const Loop &loop, const std::string &name)
+{
+    // the value is the element that the loop is at
+    if (loop.elements && name == loop.name) { _out << "element" << loop.suffix; return; }
+
+    // the key is the position of the element, which is only turned into a variable when a pointer is needed
+    _out << "callbacks->counter(userdata,"; string(name); _out << ",(numeric_t)index" << loop.suffix << " - 1)";
+}
+
+/**
+ *  The suffix for the local variables of the innermost loop with a
+ *  certain value variable
+ *  @param  name            The magic variable name for the values
+ *  @return std::string
+ *  @throws CompileError    If there is no such loop
+ */
+std::string CCode::suffix(const std::string &name) const
+{
+    // look for the loop, starting with the innermost one
+    for (auto iter = _loops.rbegin(); iter != _loops.rend(); ++iter) if (iter->name == name) return iter->suffix;
+
+    // the property is used outside its loop
+    throw CompileError("Loop property of $" + name + " used outside its foreach loop");
+}
+
+/**
+ *  Generate the number of the current iteration of a loop (starting at one)
+ *  @param  name            The magic variable name for the values of the loop
+ */
+void CCode::loopIteration(const std::string &name)
+{
+    // every fetched element increments the index, so it holds the iteration number
+    _out << "(numeric_t)index" << suffix(name);
+}
+
+/**
+ *  Generate the total number of iterations of a loop
+ *  @param  name            The magic variable name for the values of the loop
+ */
+void CCode::loopTotal(const std::string &name)
+{
+    // the local variables of the loop
+    auto suffix = this->suffix(name);
+
+    // the size is already known for vectors, and for values of which it was
+    // retrieved before, only the others have to be asked for their members
+    _out << "(numeric_t)(known" << suffix << " ? size" << suffix << " : (known" << suffix << " = 1, size" << suffix << " = callbacks->member_count(userdata,source" << suffix << ")))";
+}
+
+/**
+ *  Evaluate the variables inside the body of a loop that do not change
+ *  from one iteration to the next
+ *  @param  key             The magic variable name for the keys
+ *  @param  value           The magic variable name for the values
+ *  @param  statements      The statements that are executed on each iteration
+ *  @return std::vector     Identifiers of the variables that were evaluated
+ */
+std::vector<const void *> CCode::invariants(const std::string &key, const std::string &value, const Statements *statements)
+{
+    // find the variables that do not change
+    Invariants invariants(key, value);
+    statements->invariants(invariants);
+
+    // the identifiers that we're going to evaluate
+    std::vector<const void *> result;
+
+    // evaluate all variables
+    for (auto *variable : invariants.variables())
+    {
+        // filters are generated through their modifiers, so those identify them
+        auto *filter = dynamic_cast<const Filter *>(variable);
+        const void *id = filter ? (const void *)filter->modifiers() : (const void *)variable;
+
+        // skip variables that were already evaluated before an outer loop
+        if (_invariants.find(id) != _invariants.end()) continue;
+
+        // store the value in a local variable
+        std::string name("invariant" + std::to_string(_invariantCount++));
+        _out << "const void *" << name;
+
+        // plain variables can be evaluated right away
+        if (!filter) { _out << " = "; pointer(variable); _out << ';' << std::endl; }
+        else
+        {
+            // the filter is only evaluated when the data object did not replace any of
+            // its modifiers, a null pointer means that it has to be applied in the loop
+            _out << " = NULL;" << std::endl << "if (";
+
+            // check the modifiers that are going to be used
+            for (const auto &modifier : *filter->modifiers())
+            {
+                if (modifier != *filter->modifiers()->begin()) _out << " && ";
+                _out << "callbacks->pure_modifier(userdata,callbacks->modifier(userdata,";
+                string(modifier->token());
+                _out << "))";
+            }
+
+            // evaluate the filter
+            _out << ") " << name << " = "; pointer(variable); _out << ';' << std::endl;
+        }
+
+        // from now on the local variable is used
+        _invariants[id] = name;
+
+        // remember the identifier
+        result.push_back(id);
+    }
+
+    // done
+    return result;
+}
+
 /**
  *  Generate the code to assign the output of an expression to a key
  *  @param key                  The key to assign the output to
@@ -824,13 +1257,23 @@ void CCode::assign(const std::string &key, const Expression *expression)
         expression->boolean(this);
         break;
     case Expression::Type::Value: {
+        // the string of a filter is left open, the assign callback takes it over
+        const Filter *filter = dynamic_cast<const Filter*>(expression);
+        if (filter)
+        {
+            _out << "callbacks->assign(userdata,";
+            string(key); _out << ',';
+            this->filter(filter->modifiers(), filter->variable(), true);
+            break;
+        }
+
         const Variable *variable = dynamic_cast<const Variable*>(expression);
         if (variable)
         {
             // If we are a variable just convert it to a pointer and pass that to the assign callback
             _out << "callbacks->assign(userdata,";
             string(key); _out << ',';
-            variable->pointer(this);
+            pointer(variable);
             break;
         }
         throw CompileError("Unsupported assign");
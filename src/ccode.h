@@ -28,6 +28,155 @@ private:
      */
     std::ostringstream _out;
 
+    /**
+     *  Slots for the paths that start with a variable name, identical paths
+     *  share a slot so that they are resolved only once
+     *  @var    std::map
+     */
+    std::map<std::string, size_t> _slots;
+
+    /**
+     *  Names of the local variables that hold the values that were evaluated
+     *  before a loop, indexed by the variable (or the modifiers of a filter)
+     *  @var    std::map
+     */
+    std::map<const void *, std::string> _invariants;
+
+    /**
+     *  Number of local variables that were created for invariant values
+     *  @var    size_t
+     */
+    size_t _invariantCount = 0;
+
+    /**
+     *  A foreach loop that is being generated
+     */
+    struct Loop
+    {
+        /**
+         *  The magic variable name for the values
+         *  @var    std::string
+         */
+        std::string name;
+
+        /**
+         *  The magic variable name for the keys
+         *  @var    std::string
+         */
+        std::string key;
+
+        /**
+         *  The suffix for the local variables of the loop
+         *  @var    std::string
+         */
+        std::string suffix;
+
+        /**
+         *  Is the key of a vector read from the index, instead of being
+         *  bound to the variable on every iteration?
+         *  @var    bool
+         */
+        bool keys;
+
+        /**
+         *  Is the value of a vector read from its elements, instead of being
+         *  bound to the variable on every iteration?
+         *  @var    bool
+         */
+        bool elements;
+    };
+
+    /**
+     *  The foreach loops that are being generated, the innermost loop is at the back
+     *  @var    std::vector
+     */
+    std::vector<Loop> _loops;
+
+    /**
+     *  The loop that reads a variable straight from a vector, if the loop
+     *  iterates over a vector, instead of binding it on every iteration
+     *  @param  name            The name of the variable
+     *  @return const Loop*     The loop, or nullptr if the variable is looked up by name
+     */
+    const Loop *direct(const std::string &name) const;
+
+    /**
+     *  Generate the pointer to a variable that a loop reads straight from
+     *  the vector that it iterates over
+     *  @param  loop            The loop
+     *  @param  name            The name of the variable
+     */
+    void element(const Loop &loop, const std::string &name);
+
+    /**
+     *  The suffix for the local variables of a loop, nested loops need
+     *  their own names so that the state of outer loops remains accessible
+     *  @param  depth           Depth of the loop (zero for the outermost loop)
+     *  @return std::string
+     */
+    static std::string suffix(size_t depth)
+    {
+        return depth ? std::to_string(depth) : std::string();
+    }
+
+    /**
+     *  The suffix for the local variables of the innermost loop with a
+     *  certain value variable
+     *  @param  name            The magic variable name for the values
+     *  @return std::string
+     *  @throws CompileError    If there is no such loop
+     */
+    std::string suffix(const std::string &name) const;
+
+    /**
+     *  The variable names of the for loops that are being generated, the
+     *  innermost loop is at the back
+     *  @var    std::vector
+     */
+    std::vector<std::string> _counters;
+
+    /**
+     *  The local variable that holds the counter of a for loop that a
+     *  variable refers to
+     *  @param  variable        The variable
+     *  @return std::string     Name of the local variable, or empty if the variable is not a counter
+     */
+    std::string counter(const Variable *variable) const;
+
+    /**
+     *  Generate the pointer to a variable
+     *  @param  variable
+     */
+    void pointer(const Variable *variable);
+
+    /**
+     *  Generate the code to apply a set of modifiers, the call to apply the
+     *  last modifier should already have been written, and it is left open so
+     *  that more arguments can be added
+     *  @param  modifiers       The set of modifiers to apply
+     *  @param  variable        The variable to apply the modifiers to
+     */
+    void pipeline(const Modifiers *modifiers, const Variable *variable);
+
+    /**
+     *  Generate the code to apply a set of modifiers on an expression, or to
+     *  use the value that was evaluated before the loop
+     *  @param  modifiers       The set of modifiers to apply
+     *  @param  variable        The variable to apply the modifiers to
+     *  @param  open            Leave the string of the pipeline open for its consumer
+     */
+    void filter(const Modifiers *modifiers, const Variable *variable, bool open);
+
+    /**
+     *  Evaluate the variables inside the body of a loop that do not change
+     *  from one iteration to the next
+     *  @param  key             The magic variable name for the keys
+     *  @param  value           The magic variable name for the values
+     *  @param  statements      The statements that are executed on each iteration
+     *  @return std::vector     Identifiers of the variables that were evaluated
+     */
+    std::vector<const void *> invariants(const std::string &key, const std::string &value, const Statements *statements);
+
     /**
      *  Output raw data
      *  @param  data        buffer to output
@@ -62,16 +211,19 @@ private:
 
     /**
      *  Generate the code to get a pointer to a variable
-     *  There are three formats, to get a pointer to a literal variable by name,
-     *  to get a pointer to a variable inside a table with a literal name, and
-     *  to get a pointer to a variable with variable name
+     *  There are four formats, to get a pointer to a literal variable by name,
+     *  to get a pointer to a variable inside a table with a literal name, to
+     *  get a pointer to a variable with variable name, and to get a pointer
+     *  to a variable at the end of a path of literal members
      *  @param  parent              parent variable from which the var is retrieved
      *  @param  name                name of the variable
      *  @param  expression          Expression that evaluates to a var name
+     *  @param  path                Path of members (the parent is nullptr if the path starts with a variable name)
      */
     void varPointer(const Variable *parent, const std::string &name) override;
     void varPointer(const Variable *parent, const Expression *expression) override;
     void varPointer(const std::string &name) override;
+    void varPointer(const Variable *parent, const Path &path) override;
 
     /**
      *  Create a string or numeric literal
@@ -165,6 +317,24 @@ private:
      */
     void foreach(const Variable *variable, const std::string &key, const std::string &value, const Statements *statements, const Statements *else_statements) override;
 
+    /**
+     *  Generate the code to count from one number to another
+     *  @param name             The magic variable name for the counter
+     *  @param from             The first value of the counter
+     *  @param to               The last value of the counter
+     *  @param step             The value to add after every iteration (nullptr for 1)
+     *  @param statements       The statements to execute on each iteration
+     */
+    void count(const std::string &name, const Expression *from, const Expression *to, const Expression *step, const Statements *statements) override;
+
+    /**
+     *  Generate the counters of a foreach loop: the number of the current
+     *  iteration (starting at one), and the total number of iterations
+     *  @param  name            The magic variable name for the values of the loop
+     */
+    void loopIteration(const std::string &name) override;
+    void loopTotal(const std::string &name) override;
+
     /**
      *  Generate the code to assign the output of an expression to a key
      *  @param key                  The key to assign the output to
@@ -17,79 +17,13 @@
  */
 namespace SmartTpl {
 
-static Internal::ToUpperModifier         toupper;
-static Internal::ToLowerModifier         tolower;
-static Internal::CatModifier             cat;
-static Internal::CountWordsModifier      count_words;
-static Internal::CountCharactersModifier count_characters;
-static Internal::CountParagraphsModifier count_paragraphs;
-static Internal::DefaultModifier         _default; // Underscore is purely because default is a keyword
-static Internal::EscapeModifier          escape;
-static Internal::IndentModifier          indent;
-static Internal::ReplaceModifier         replace;
-static Internal::Nl2brModifier           nl2br;
-static Internal::SpacifyModifier         spacify;
-static Internal::TruncateModifier        truncate;
-static Internal::CountModifier           count;
-static Internal::EmptyModifier           empty;
-static Internal::StrlenModifier          strlen;
-static Internal::UcFirstModifier         ucfirst;
-static Internal::TrimModifier            trim;
-static Internal::RegexReplaceModifier    regex_replace;
-static Internal::SubStrModifier          substr;
-static Internal::StrStrModifier          strstr;
-static Internal::UrlencodeModifier       urlencode;
-static Internal::UrldecodeModifier       urldecode;
-static Internal::Md5Modifier             md5;
-static Internal::Sha1Modifier            sha1;
-static Internal::Sha256Modifier          sha256;
-static Internal::Sha512Modifier          sha512;
-static Internal::Base64EncodeModifier    base64_encode;
-static Internal::Base64DecodeModifier    base64_decode;
-static Internal::RangeModifier           range_modifier;
-
 /**
  *  Constructor
+ *
+ *  The built-in modifiers are not registered here, they are looked up in the
+ *  process wide table when they are not overridden
  */
-Data::Data()
-: _modifiers({{"toupper",          &toupper},
-              {"upper",            &toupper},
-              {"tolower",          &tolower},
-              {"lower",            &tolower},
-              {"cat",              &cat},
-              {"count_words",      &count_words},
-              {"count_characters", &count_characters},
-              {"count_paragraphs", &count_paragraphs},
-              {"default",          &_default},
-              {"escape",           &escape},
-              {"indent",           &indent},
-              {"replace",          &replace},
-              {"nl2br",            &nl2br},
-              {"spacify",          &spacify},
-              {"truncate",         &truncate},
-              {"count",            &count},
-              {"strlen",           &strlen},
-              {"empty",            &empty},
-              {"ucfirst",          &ucfirst},
-              {"trim",             &trim},
-              {"regex_replace",    &regex_replace},
-              {"substr",           &substr},
-              {"strstr",           &strstr},
-              {"urlencode",        &urlencode},
-              {"urldecode",        &urldecode},
-              {"range",            &range_modifier}}) // register built-in modifiers
-{
-    // in case the openssl library is valid we are loading all the modifiers that use it
-    if (Internal::OpenSSL::instance())
-    {
-        _modifiers.insert({{"md5",              &md5},
-                           {"sha1",             &sha1},
-                           {"sha256",           &sha256},
-                           {"sha512",           &sha512},
-                           {"base64_encode",    &base64_encode},
-                           {"base64_decode",    &base64_decode}});
-    }
-}
+Data::Data() {}
 
 /**
  *  Move constructor
@@ -97,7 +31,10 @@ Data::Data()
 Data::Data(Data&& that)
 : _variables(std::move(that._variables)),
   _managed_values(std::move(that._managed_values)),
-  _modifiers(std::move(that._modifiers))
+  _modifiers(std::move(that._modifiers)),
+  _parent(that._parent),
+  _resolver(std::move(that._resolver)),
+  _cache(that._cache)
 {
 }
 
@@ -182,6 +119,18 @@ Data &Data::assignManaged(const std::string &name, std::shared_ptr<Value> &value
     return *this;
 }
 
+/**
+ *  Assign a JSON document
+ *  @param  name        Name of the variable
+ *  @param  json        The JSON text
+ *  @return Data        Same object for chaining
+ */
+Data &Data::assignJson(const std::string &name, std::string json)
+{
+    // the buffer is moved into the value, it is indexed when it is used
+    return assign(name, Internal::JsonValue::parse(std::move(json)));
+}
+
 /**
  *  Assign a callback
  *  @param  name        Name of the variable
@@ -190,9 +139,92 @@ Data &Data::assignManaged(const std::string &name, std::shared_ptr<Value> &value
  *  @return Data        Same object for chaining
  */
 Data &Data::callback(const std::string &name, const Callback &callback, bool cache)
+{
+    // a cached callback is called only once
+    return this->callback(name, callback, cache ? Caching::Forever : Caching::None);
+}
+
+/**
+ *  Assign a callback, and specify how long its value may be cached
+ *  @param  name        Name of the variable
+ *  @param  callback    Callback function
+ *  @param  caching     How long may the value be cached?
+ *  @return Data        Same object for chaining
+ */
+Data &Data::callback(const std::string &name, const Callback &callback, Caching caching)
+{
+    // construct variable
+    Value *v = new Internal::CallbackValue(callback, caching);
+
+    // make our Value managed
+    _managed_values.emplace_back(v);
+
+    // and store in the list of variables
+    _variables[name] = v;
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Assign a callback that returns a number
+ *  @param  name        Name of the variable
+ *  @param  callback    Callback function
+ *  @return Data        Same object for chaining
+ */
+Data &Data::callbackNumeric(const std::string &name, const NumericCallback &callback)
+{
+    // construct variable, and make it managed
+    return assignManaged(name, new Internal::NumericCallbackValue(callback));
+}
+
+/**
+ *  Assign a callback that returns a boolean
+ *  @param  name        Name of the variable
+ *  @param  callback    Callback function
+ *  @return Data        Same object for chaining
+ */
+Data &Data::callbackBoolean(const std::string &name, const BooleanCallback &callback)
+{
+    // construct variable, and make it managed
+    return assignManaged(name, new Internal::BooleanCallbackValue(callback));
+}
+
+/**
+ *  Assign a callback that returns a floating point value
+ *  @param  name        Name of the variable
+ *  @param  callback    Callback function
+ *  @return Data        Same object for chaining
+ */
+Data &Data::callbackDouble(const std::string &name, const DoubleCallback &callback)
+{
+    // construct variable, and make it managed
+    return assignManaged(name, new Internal::DoubleCallbackValue(callback));
+}
+
+/**
+ *  Assign a callback that writes a string
+ *  @param  name        Name of the variable
+ *  @param  callback    Callback function
+ *  @return Data        Same object for chaining
+ */
+Data &Data::callbackString(const std::string &name, const StringCallback &callback)
+{
+    // construct variable, and make it managed
+    return assignManaged(name, new Internal::StringCallbackValue(callback));
+}
+
+/**
+ *  Assign a variable that produces its elements on demand
+ *  @param  name        Name of the variable
+ *  @param  callback    Function that creates a new generator
+ *  @param  chunk       Max number of elements to fetch at once
+ *  @return Data        Same object for chaining
+ */
+Data &Data::iterable(const std::string &name, const Iterable &callback, size_t chunk)
 {
     // construct variable
-    Value *v = new Internal::CallbackValue(callback, cache);
+    Value *v = new Internal::GeneratorValue(callback, chunk);
 
     // make our Value managed
     _managed_values.emplace_back(v);
@@ -204,6 +236,22 @@ Data &Data::callback(const std::string &name, const Callback &callback, bool cac
     return *this;
 }
 
+/**
+ *  Install a resolver for variables that are not assigned
+ *  @param  callback    Function that returns the value of a variable
+ *  @param  cache       Should we cache the values returned by the resolver?
+ *  @return Data        Same object for chaining
+ */
+Data &Data::resolver(const Resolver &callback, bool cache)
+{
+    // store the resolver
+    _resolver = callback;
+    _cache = cache;
+
+    // allow chaining
+    return *this;
+}
+
 /**
  *  Assign a modifier
  *  @param  name        Name of the modifier
@@ -226,13 +274,47 @@ Data &Data::modifier(const std::string &name, Modifier* modifier)
  *  @return Variant
  */
 const Value *Data::value(const char *name, size_t size) const
+{
+    // assigned variables are used before the resolvers are called
+    auto *result = assigned(name);
+
+    // ask the resolvers if nothing was assigned
+    return result ? result : resolve(name, size);
+}
+
+/**
+ *  Look up a variable that was assigned to this object or to one of its parents
+ *  @param  name        the name
+ *  @return Value*
+ */
+const Value *Data::assigned(const char *name) const
 {
     // look it up in _variables
     auto iter = _variables.find(name);
     if (iter != _variables.end()) return iter->second;
 
-    // return nullptr if we found nothing
-    return nullptr;
+    // look it up in the parent, or return nullptr if we found nothing
+    return _parent ? _parent->assigned(name) : nullptr;
+}
+
+/**
+ *  Ask the resolvers of this object and its parents for a variable
+ *  @param  name        the name
+ *  @param  size        size of the name
+ *  @return Value*
+ */
+const Value *Data::resolve(const char *name, size_t size) const
+{
+    // ask our own resolver first
+    if (_resolver)
+    {
+        // the value is only used if the resolver knows the variable
+        auto *result = _resolver(name, size);
+        if (result) return result;
+    }
+
+    // ask the resolver of the parent, or return nullptr if there is none
+    return _parent ? _parent->resolve(name, size) : nullptr;
 }
 
 /**
@@ -243,12 +325,16 @@ const Value *Data::value(const char *name, size_t size) const
  */
 Modifier *Data::modifier(const char* name, size_t size) const
 {
-    // check if the modifier is listed
-    auto iter = _modifiers.find(name);
-    if (iter == _modifiers.end()) return nullptr;
+    // the modifiers that were registered by the user take precedence
+    if (!_modifiers.empty())
+    {
+        // check if the modifier is listed
+        auto iter = _modifiers.find(std::string(name, size));
+        if (iter != _modifiers.end()) return iter->second;
+    }
 
-    // get the pointer
-    return iter->second;
+    // fall back to the parent, or to the built-in modifiers
+    return _parent ? _parent->modifier(name, size) : Internal::Builtins::find(name, size);
 }
 
 /**
@@ -265,8 +351,8 @@ bool Data::contains(const Value *value) const
         if (variable.second == value) return true;
     }
     
-    // the value was not found
-    return false;
+    // the value might be in the parent
+    return _parent && _parent->contains(value);
 }
 
 
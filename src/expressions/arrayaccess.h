@@ -38,6 +38,17 @@ public:
      *  Destructor
      */
     virtual ~ArrayAccess() {}
+
+    /**
+     *  Collect the names of the variables that the expression depends on
+     *  @param  names       the set to add the names to
+     *  @return bool
+     */
+    virtual bool names(std::set<std::string> &names) const override
+    {
+        // we depend on the same names as the underlying variable
+        return _var->names(names);
+    }
 };
 
 /**
@@ -42,6 +42,26 @@ public:
      */
     virtual Type type() const override { return Type::Boolean; };
 
+    /**
+     *  Collect the names of the variables that the expression depends on
+     *  @param  names       the set to add the names to
+     *  @return bool
+     */
+    bool names(std::set<std::string> &names) const override
+    {
+        return _expression->names(names);
+    }
+
+    /**
+     *  Collect the variables inside the expression that might not change
+     *  during a loop
+     *  @param  invariants
+     */
+    void invariants(Invariants &invariants) const override
+    {
+        _expression->invariants(invariants);
+    }
+
     /**
      *  Generate the instruction
      *  @param  generator
@@ -50,6 +50,24 @@ public:
      */
     virtual Type type() const = 0;
 
+    /**
+     *  Collect the names of the variables that the expression depends on
+     *  @param  names       the set to add the names to
+     *  @return bool        false if the expression can not be evaluated in advance at all
+     */
+    virtual bool names(std::set<std::string> &names) const
+    {
+        // literals do not depend on anything
+        return true;
+    }
+
+    /**
+     *  Collect the variables inside the expression that might not change
+     *  during a loop
+     *  @param  invariants
+     */
+    virtual void invariants(Invariants &invariants) const {}
+
     /**
      *  Generate the expression as a numeric value
      *  @param  generator
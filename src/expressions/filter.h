@@ -50,6 +50,47 @@ public:
      */
     Type type() const override { return Type::Value; };
 
+    /**
+     *  The modifiers that are applied
+     *  @return Modifiers
+     */
+    const Modifiers *modifiers() const { return _modifiers.get(); }
+
+    /**
+     *  The variable that the modifiers are applied to
+     *  @return Variable
+     */
+    const Variable *variable() const { return _variable.get(); }
+
+    /**
+     *  Collect the names of the variables that the expression depends on,
+     *  a filter can only be evaluated in advance if all its modifiers are pure
+     *  @param  names       the set to add the names to
+     *  @return bool
+     */
+    bool names(std::set<std::string> &names) const override
+    {
+        // the variable itself should be able to be evaluated in advance
+        if (!_variable->names(names)) return false;
+
+        // check all modifiers
+        for (auto &modifier : *_modifiers)
+        {
+            // modifiers with side effects should be applied every time
+            if (!modifier->pure()) return false;
+
+            // the parameters can depend on other variables too
+            auto *parameters = modifier->parameters();
+            if (!parameters) continue;
+
+            // check all parameters
+            for (auto &parameter : *parameters) if (!parameter->names(names)) return false;
+        }
+
+        // we can be evaluated in advance
+        return true;
+    }
+
     /**
      *  Generate the output that leaves a pointer to the variable
      *  @param  generator
@@ -25,6 +25,18 @@ protected:
      */
     std::unique_ptr<Token> _key;
 
+    /**
+     *  The path of literal members that leads to this variable
+     *  @var    Path
+     */
+    Path _path;
+
+    /**
+     *  The variable where the path starts, or nullptr if it starts with a name
+     *  @var    Variable
+     */
+    const Variable *_base;
+
 public:
     /**
      *  Constructor
@@ -33,7 +45,12 @@ public:
      */
     LiteralArrayAccess(Variable *variable, Token *token) :
         ArrayAccess(variable),
-        _key(token) {}
+        _key(token),
+        _base(variable->path(_path))
+    {
+        // we are the last member of the path
+        _path.member(*_key);
+    }
 
     /**
      *  Destructor
@@ -52,8 +69,24 @@ public:
      */
     void pointer(Generator *generator) const override
     {
-        // generate the code to access a member
-        generator->varPointer(_var.get(), *_key);
+        // a single member of a variable that is not part of the path is
+        // accessed directly, longer paths are resolved all at once
+        if (_base == _var.get()) generator->varPointer(_var.get(), *_key);
+        else generator->varPointer(_base, _path);
+    }
+
+    /**
+     *  Collect the literal members that lead to this variable in a path
+     *  @param  path        the path to fill
+     *  @return Variable    the variable where the path starts
+     */
+    const Variable *path(Path &path) const override
+    {
+        // copy our own path
+        path = _path;
+
+        // and the variable where it starts
+        return _base;
     }
 };
 
@@ -47,6 +47,12 @@ public:
      */
     Type type() const override { return Type::Numeric; }
 
+    /**
+     *  The value of the literal
+     *  @return numeric_t
+     */
+    numeric_t value() const { return _value; }
+
     /**
      *  Generate the code to get the const char * to the expression
      *  @param  generator
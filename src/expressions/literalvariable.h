@@ -43,6 +43,12 @@ public:
      */
     Type type() const override { return Type::Value; }
 
+    /**
+     *  Name of the variable
+     *  @return std::string
+     */
+    const std::string &name() const { return *_name; }
+
     /**
      *  Generate the output that leaves a pointer to the variable
      *  @param  generator
@@ -53,6 +59,34 @@ public:
         generator->varPointer(*_name);
     }
 
+    /**
+     *  Collect the names of the variables that the expression depends on
+     *  @param  names       the set to add the names to
+     *  @return bool
+     */
+    bool names(std::set<std::string> &names) const override
+    {
+        // we depend on our own name
+        names.insert(*_name);
+
+        // and we can be evaluated in advance
+        return true;
+    }
+
+    /**
+     *  Collect the literal members that lead to this variable in a path
+     *  @param  path        the path to fill
+     *  @return Variable    nullptr, because the path starts with our name
+     */
+    const Variable *path(Path &path) const override
+    {
+        // the path starts with our name
+        path.variable(*_name);
+
+        // there is no variable before us
+        return nullptr;
+    }
+
 };
 
 /**
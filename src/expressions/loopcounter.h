@@ -0,0 +1,92 @@
+/**
+ *  LoopCounter.h
+ *
+ *  A counter of an enclosing foreach loop, either the number of the current
+ *  iteration or the total number of iterations. The counters are kept by the
+ *  generated code itself, so reading them does not involve any callbacks.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class LoopCounter : public Expression
+{
+private:
+    /**
+     *  The magic variable name for the values of the loop
+     *  @var    std::string
+     */
+    const std::string _name;
+
+    /**
+     *  Is this the total number of iterations (instead of the current iteration)?
+     *  @var    bool
+     */
+    const bool _total;
+
+public:
+    /**
+     *  Constructor
+     *  @param  name        name of the value variable of the loop
+     *  @param  total       the total number of iterations instead of the current one
+     */
+    LoopCounter(const std::string &name, bool total) : _name(name), _total(total) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~LoopCounter() {}
+
+    /**
+     *  The return type of the expression
+     *  @return Type
+     */
+    Type type() const override { return Type::Numeric; }
+
+    /**
+     *  Collect the names of the variables that the expression depends on
+     *  @param  names       the set to add the names to
+     *  @return bool
+     */
+    bool names(std::set<std::string> &names) const override
+    {
+        // the counter changes together with the value of the loop
+        names.insert(_name);
+
+        // we can be evaluated in advance outside our own loop
+        return true;
+    }
+
+    /**
+     *  Generate the code to get the numeric value of the expression
+     *  @param  generator
+     */
+    void numeric(Generator *generator) const override
+    {
+        if (_total) generator->loopTotal(_name);
+        else generator->loopIteration(_name);
+    }
+
+    /**
+     *  Generate the code to get the boolean value of the expression
+     *  @param  generator
+     */
+    void boolean(Generator *generator) const override
+    {
+        // the counter is true when it is not zero
+        numeric(generator);
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
@@ -0,0 +1,139 @@
+/**
+ *  LoopProperty.h
+ *
+ *  A property of an enclosing foreach loop, like $item@index. The supported
+ *  properties are @index (starting at zero), @iteration (starting at one),
+ *  @first, @last and @total. They are all derived from the counters of the
+ *  loop, and @total is only retrieved from the value that is iterated over
+ *  when it is actually used. Values that do not know their number of members,
+ *  like generators, are then counted with an iterator of their own.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class LoopProperty : public Expression
+{
+private:
+    /**
+     *  Name of the property, for error messages
+     *  @var    std::string
+     */
+    std::string _property;
+
+    /**
+     *  The expression that calculates the property (nullptr for unknown properties)
+     *  @var    std::unique_ptr
+     */
+    std::unique_ptr<Expression> _expression;
+
+    /**
+     *  The expression that calculates the property
+     *  @return const Expression*
+     *  @throws CompileError    For unknown properties
+     */
+    const Expression *expression() const
+    {
+        // the property should exist
+        if (!_expression) throw CompileError("Unknown loop property @" + _property);
+
+        // expose the expression
+        return _expression.get();
+    }
+
+public:
+    /**
+     *  Constructor
+     *  @param  variable    the magic variable name for the values of the loop
+     *  @param  property    the name of the property
+     */
+    LoopProperty(Token *variable, Token *property) : _property(*property)
+    {
+        // we no longer need the tokens
+        std::string name(*variable);
+        delete variable;
+        delete property;
+
+        // the tokenizer is case insensitive, so we compare in lower case
+        std::string lower(_property);
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+        // the properties are all derived from the number of the current iteration
+        // and the total number of iterations
+        if (lower == "iteration") _expression.reset(new LoopCounter(name, false));
+        else if (lower == "total") _expression.reset(new LoopCounter(name, true));
+        else if (lower == "index") _expression.reset(new BinaryMinusOperator(new LoopCounter(name, false), new LiteralNumeric(new Token("1"))));
+        else if (lower == "first") _expression.reset(new BinaryEqualsOperator(new LoopCounter(name, false), new LiteralNumeric(new Token("1"))));
+        else if (lower == "last") _expression.reset(new BinaryEqualsOperator(new LoopCounter(name, false), new LoopCounter(name, true)));
+    }
+
+    /**
+     *  Destructor
+     */
+    virtual ~LoopProperty() {}
+
+    /**
+     *  The return type of the expression
+     *  @return Type
+     */
+    Type type() const override
+    {
+        return _expression ? _expression->type() : Type::Numeric;
+    }
+
+    /**
+     *  Collect the names of the variables that the expression depends on
+     *  @param  names       the set to add the names to
+     *  @return bool
+     */
+    bool names(std::set<std::string> &names) const override
+    {
+        return _expression ? _expression->names(names) : false;
+    }
+
+    /**
+     *  Generate the code to get the numeric value of the expression
+     *  @param  generator
+     */
+    void numeric(Generator *generator) const override
+    {
+        expression()->numeric(generator);
+    }
+
+    /**
+     *  Generate the code to get the boolean value of the expression
+     *  @param  generator
+     */
+    void boolean(Generator *generator) const override
+    {
+        expression()->boolean(generator);
+    }
+
+    /**
+     *  Generate the code to get the const char * to the expression, numeric
+     *  properties are written as numbers, so this is only used for @first
+     *  and @last, which have no output just like other booleans
+     *  @param  generator
+     */
+    void string(Generator *generator) const override
+    {
+        // check if the property exists
+        expression();
+
+        // booleans have no output
+        generator->string("");
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
@@ -35,6 +35,32 @@ public:
      */
     virtual void pointer(Generator *generator) const = 0;
 
+    /**
+     *  Collect the literal members that lead to this variable in a path, so
+     *  that they can be looked up with a single call
+     *  @param  path        the path to fill (it should be empty)
+     *  @return Variable    the variable where the path starts, or nullptr if it starts with a variable name
+     */
+    virtual const Variable *path(Path &path) const
+    {
+        // by default nothing can be collected
+        return this;
+    }
+
+    /**
+     *  Collect the variables inside the expression that might not change
+     *  during a loop, a variable is a candidate as a whole
+     *  @param  invariants
+     */
+    virtual void invariants(Invariants &invariants) const override
+    {
+        // the names that we depend on
+        std::set<std::string> dependencies;
+
+        // we are a candidate if we can be evaluated in advance
+        if (names(dependencies)) invariants.candidate(this, std::move(dependencies));
+    }
+
     /**
      *  Generate a numeric code for the variable
      *  @param  generator
@@ -25,6 +25,19 @@ protected:
      */
     std::unique_ptr<Expression> _key;
 
+    /**
+     *  The path of literal members that leads to this variable
+     *  @var    Path
+     */
+    Path _path;
+
+    /**
+     *  The variable where the path starts, or nullptr if it starts with a
+     *  name, this is the object itself if the key is not a literal number
+     *  @var    Variable
+     */
+    const Variable *_base = this;
+
 public:
     /**
      *  Constructor
@@ -33,7 +46,16 @@ public:
      */
     VariableArrayAccess(Variable *variable, Expression *key) :
         ArrayAccess(variable),
-        _key(key) {}
+        _key(key)
+    {
+        // only literal positions can be part of a path
+        auto *literal = dynamic_cast<LiteralNumeric*>(key);
+        if (!literal) return;
+
+        // we are the last member of the path
+        _base = variable->path(_path);
+        _path.position(literal->value());
+    }
 
     /**
      *  Destructor
@@ -52,7 +74,38 @@ public:
      */
     void pointer(Generator *generator) const override
     {
-        generator->varPointer(_var.get(), _key.get());
+        // a single member of a variable that is not part of the path is
+        // accessed directly, longer paths are resolved all at once
+        if (_base == this || _base == _var.get()) generator->varPointer(_var.get(), _key.get());
+        else generator->varPointer(_base, _path);
+    }
+
+    /**
+     *  Collect the names of the variables that the expression depends on
+     *  @param  names       the set to add the names to
+     *  @return bool
+     */
+    bool names(std::set<std::string> &names) const override
+    {
+        // we depend on the underlying variable and on the key
+        return _var->names(names) && _key->names(names);
+    }
+
+    /**
+     *  Collect the literal members that lead to this variable in a path
+     *  @param  path        the path to fill
+     *  @return Variable    the variable where the path starts
+     */
+    const Variable *path(Path &path) const override
+    {
+        // if we are not part of a path, the path starts with us
+        if (_base == this) return this;
+
+        // copy our own path
+        path = _path;
+
+        // and the variable where it starts
+        return _base;
     }
 };
 
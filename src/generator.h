@@ -79,16 +79,19 @@ public:
 
     /**
      *  Generate the code to get a pointer to a variable
-     *  There are three formats, to get a pointer to a literal variable by name,
-     *  to get a pointer to a variable inside a table with a literal name, and
-     *  to get a pointer to a variable with variable name
+     *  There are four formats, to get a pointer to a literal variable by name,
+     *  to get a pointer to a variable inside a table with a literal name, to
+     *  get a pointer to a variable with variable name, and to get a pointer
+     *  to a variable at the end of a path of literal members
      *  @param  parent              parent variable from which the var is retrieved
      *  @param  name                name of the variable
      *  @param  expression          Expression that evaluates to a var name
+     *  @param  path                Path of members (the parent is nullptr if the path starts with a variable name)
      */
     virtual void varPointer(const Variable *parent, const std::string &name) = 0;
     virtual void varPointer(const Variable *parent, const Expression *expression) = 0;
     virtual void varPointer(const std::string &name) = 0;
+    virtual void varPointer(const Variable *parent, const Path &path) = 0;
 
     /**
      *  Create a string, numeric or boolean literal
@@ -181,6 +184,24 @@ public:
      */
     virtual void foreach(const Variable *variable, const std::string &key, const std::string &value, const Statements *statements, const Statements *else_statements) = 0;
 
+    /**
+     *  Generate the code to count from one number to another
+     *  @param name             The magic variable name for the counter
+     *  @param from             The first value of the counter
+     *  @param to               The last value of the counter
+     *  @param step             The value to add after every iteration (nullptr for 1)
+     *  @param statements       The statements to execute on each iteration
+     */
+    virtual void count(const std::string &name, const Expression *from, const Expression *to, const Expression *step, const Statements *statements) = 0;
+
+    /**
+     *  Generate the counters of a foreach loop: the number of the current
+     *  iteration (starting at one), and the total number of iterations
+     *  @param  name            The magic variable name for the values of the loop
+     */
+    virtual void loopIteration(const std::string &name) = 0;
+    virtual void loopTotal(const std::string &name) = 0;
+
     /**
      *  Generate the code to assign the output of an expression to a key
      *  @param key                  The key to assign the output to
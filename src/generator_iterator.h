@@ -0,0 +1,181 @@
+/**
+ *  Generator_Iterator.h
+ *
+ *  Iterator that fetches its elements from a generator callback, the elements
+ *  are fetched in chunks, so that only a limited number of them has to be
+ *  kept in memory
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class GeneratorIterator : public SmartTpl::Iterator
+{
+private:
+    /**
+     *  The generator that produces the elements
+     *  @var    SmartTpl::Generator
+     */
+    SmartTpl::Generator _generator;
+
+    /**
+     *  Max number of elements to fetch at once
+     *  @var    size_t
+     */
+    const size_t _chunk;
+
+    /**
+     *  The elements that were fetched, but not yet iterated over
+     *  @var    std::vector
+     */
+    std::vector<VariantValue> _elements;
+
+    /**
+     *  Position of the current element in the _elements vector
+     *  @var    size_t
+     */
+    size_t _position = 0;
+
+    /**
+     *  Has the generator reported that there are no more elements?
+     *  @var    bool
+     */
+    bool _finished = false;
+
+    /**
+     *  A simple counter so we can at least return some kind of key
+     *  @var    numeric_t
+     */
+    numeric_t _count = 0;
+
+    /**
+     *  Fetch the next chunk of elements
+     */
+    void load()
+    {
+        // forget the previous chunk (this keeps the allocated memory)
+        _elements.clear();
+        _position = 0;
+
+        // call the generator until the chunk is full, or until it is finished
+        while (!_finished && _elements.size() < _chunk)
+        {
+            // add an element to store the next value in
+            _elements.emplace_back();
+
+            // fetch it, if that fails we remove the element again
+            if (_generator(_elements.back())) continue;
+
+            // the generator is finished
+            _elements.pop_back();
+            _finished = true;
+        }
+    }
+
+public:
+    /**
+     *  Constructor
+     *  @param  generator   The generator that produces the elements
+     *  @param  chunk       Max number of elements to fetch at once
+     */
+    GeneratorIterator(SmartTpl::Generator &&generator, size_t chunk) :
+        _generator(std::move(generator)), _chunk(std::max(chunk, (size_t)1))
+    {
+        // an empty function does not produce anything
+        if (!_generator) _finished = true;
+
+        // make room for the elements, and fetch the first chunk
+        _elements.reserve(_chunk);
+        load();
+    }
+
+    /**
+     *  Deconstructor
+     */
+    virtual ~GeneratorIterator() {}
+
+    /**
+     *  Check if the iterator is still valid
+     *  @return bool
+     */
+    bool valid() const override
+    {
+        return _position < _elements.size();
+    }
+
+    /**
+     *  Move to the next position
+     */
+    void next() override
+    {
+        // move to the next element
+        ++_position;
+        ++_count;
+
+        // fetch a new chunk if we've reached the end of the current one
+        if (_position >= _elements.size()) load();
+    }
+
+    /**
+     *  Retrieve pointer to the current member
+     *  @return Variant
+     */
+    VariantValue value() const override
+    {
+        return _elements[_position];
+    }
+
+    /**
+     *  Retrieve a pointer to the current key
+     *  @return Variant
+     */
+    VariantValue key() const override
+    {
+        return _count;
+    }
+
+    /**
+     *  Fetch a number of elements at once, and move past them, this never
+     *  returns more elements than are left in the current chunk, so that
+     *  the generator is not asked for more elements than necessary
+     *  @param  keys        Array for the keys, or nullptr
+     *  @param  values      Array for the values
+     *  @param  max         Size of the arrays
+     *  @return size_t      Number of elements that were fetched
+     */
+    size_t fetch(VariantValue *keys, VariantValue *values, size_t max) override
+    {
+        // number of elements that are left in the chunk
+        size_t count = std::min(max, _elements.size() - _position);
+
+        // move the elements out of the chunk
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (keys) keys[i] = (numeric_t)(_count + i);
+            values[i] = std::move(_elements[_position + i]);
+        }
+
+        // move past them
+        _position += count;
+        _count += count;
+
+        // fetch a new chunk if we've reached the end of the current one
+        if (count > 0 && _position >= _elements.size()) load();
+
+        // done
+        return count;
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
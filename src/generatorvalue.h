@@ -0,0 +1,133 @@
+/**
+ *  GeneratorValue.h
+ *
+ *  Implementation of the Value class for variables that can only be iterated
+ *  over. The elements are produced on demand by a generator that is created
+ *  every time a template starts a foreach loop over the variable.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class GeneratorValue : public Value
+{
+private:
+    /**
+     *  The function that creates a new generator
+     *  @var    Iterable
+     */
+    Iterable _callback;
+
+    /**
+     *  Max number of elements that are fetched at once
+     *  @var    size_t
+     */
+    const size_t _chunk;
+
+public:
+    /**
+     *  Constructor
+     *  @param  callback    The function that creates a new generator
+     *  @param  chunk       Max number of elements to fetch at once
+     */
+    GeneratorValue(const Iterable &callback, size_t chunk) :
+        _callback(callback), _chunk(chunk) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~GeneratorValue() {}
+
+    /**
+     *  Convert the value to a string
+     *  @return std::string
+     */
+    std::string toString() const override
+    {
+        return "";
+    }
+
+    /**
+     *  Convert the variable to a numeric value
+     *  @return numeric
+     */
+    numeric_t toNumeric() const override
+    {
+        return 0;
+    }
+
+    /**
+     *  Convert the variable to a boolean value, we can not find out whether
+     *  there are elements without starting the generator, so we always
+     *  pretend that there are (use foreach/else to handle empty sets)
+     *  @return bool
+     */
+    bool toBoolean() const override
+    {
+        return true;
+    }
+
+    /**
+     *  Convert the variable to a floating point value
+     *  @return double
+     */
+    double toDouble() const override
+    {
+        return 0.0;
+    }
+
+    /**
+     *  Get access to a member value
+     *  @param  name        name of the member
+     *  @param  size        size of the name
+     *  @return VariantValue
+     */
+    VariantValue member(const char *name, size_t size) const override
+    {
+        // generators can only be iterated over
+        return nullptr;
+    }
+
+    /**
+     *  Get access to the amount of members this value has
+     *  @return size_t
+     */
+    size_t memberCount() const override
+    {
+        // the number of elements is unknown
+        return 0;
+    }
+
+    /**
+     *  Get access to a member at a certain position
+     *  @param  position    Position of the item we want to retrieve
+     *  @return VariantValue
+     */
+    VariantValue member(size_t position) const override
+    {
+        // generators can only be iterated over
+        return nullptr;
+    }
+
+    /**
+     *  Create a new iterator, this starts a new generator
+     *  @return Newly allocated Iterator
+     */
+    SmartTpl::Iterator *iterator() const override
+    {
+        return new GeneratorIterator(_callback(), _chunk);
+    }
+};
+
+/**
+ *  End of namespace
+ */
+}}
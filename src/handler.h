@@ -20,10 +20,10 @@ class Handler
 {
 private:
     /**
-     *  Output buffer
-     *  @var    std::string
+     *  Output buffer, the JIT compiled code writes directly into this buffer
+     *  @var    OutputBuffer
      */
-    std::string _buffer;
+    OutputBuffer _buffer;
 
     /**
      *  The underlying data
@@ -64,18 +64,72 @@ private:
     /**
      *  Will contain the local values that were created just here and should
      *  because of that be deleted
-     *
-     *  Can also contain externally created Values that were made managed using manageValue(Value*)
-     *  @see manageValue
+     *  @see manage
      */
     std::list<std::unique_ptr<const Value>> _managed_local_values;
 
     /**
-     *  List of iterators that we are managing
+     *  List of iterators that we are managing, the built-in iterators refer
+     *  to the values that they iterate over, so this member is declared after
+     *  the managed values to make sure that the iterators are destructed first
      *  @see manageIterator
      */
     std::list<std::unique_ptr<Iterator>> _managed_iterators;
 
+    /**
+     *  The values of the loop variables, a loop variable gets a new value on
+     *  every iteration, which is stored in the same object every time
+     *  @see step
+     */
+    std::map<const char *, std::unique_ptr<VariantValue>, cmp_str> _loop_values;
+
+    /**
+     *  The values of the counters of for loops, these are kept apart from the
+     *  loop variables, because a counter can have the same name as the
+     *  variable of an enclosing foreach loop, whose value might still be used
+     *  @see counter
+     */
+    std::map<const char *, std::unique_ptr<VariantValue>, cmp_str> _counter_values;
+
+    /**
+     *  Buffers of pipelines that were finished, and that can be reused
+     *  @see recycle
+     */
+    std::vector<BufferValue*> _buffers;
+
+    /**
+     *  Should the variables that were resolved on demand be cached? Only when
+     *  the data object has a resolver that allows it, plain data objects are
+     *  looked up directly, which is just as fast as looking in the cache
+     *  @var bool
+     */
+    const bool _caching;
+
+    /**
+     *  Variables that were resolved on demand during this run
+     *  @see variable
+     */
+    std::map<const char *, const Value*, cmp_str> _resolved;
+
+    /**
+     *  The values of the callbacks that are cached during this run
+     *  @see variable
+     */
+    std::map<const Value*, const Value*> _memoized;
+
+    /**
+     *  Paths that were already resolved during this run, indexed by the slot
+     *  that the compiler assigned to them
+     *  @see slot
+     */
+    std::vector<const Value*> _slots;
+
+    /**
+     *  The filled slots, indexed by the names of the variables that they start with
+     *  @see invalidate
+     */
+    std::map<const char *, std::vector<size_t>, cmp_str> _filled;
+
     /**
      *  List of parameters that we are managing
      *  @see manageParameters
@@ -95,18 +149,46 @@ private:
      */
     std::string _error;
 
+    /**
+     *  Buffer that is reused for writing the output of string callbacks
+     *  @var std::string
+     */
+    std::string _scratch;
+
+    /**
+     *  Store a value in the object that holds a variable during the entire
+     *  run, and use it as the value of the variable
+     *  @param  values      The objects that hold the variables
+     *  @param  key         The name of the variable
+     *  @param  value       The new value
+     *  @return const Value*
+     */
+    const Value *store(std::map<const char *, std::unique_ptr<VariantValue>, cmp_str> &values, const char *key, VariantValue &&value)
+    {
+        // paths that start with the variable are no longer valid
+        invalidate(key);
+
+        // find the object that holds the variable
+        auto &holder = values[key];
+
+        // the first time, it has to be created, later, the string of the previous value is forgotten
+        if (!holder) holder.reset(new VariantValue());
+        else _managed_strings.erase(holder.get());
+
+        // store the value
+        *holder = std::move(value);
+        return _local_values[key] = holder.get();
+    }
+
 public:
     /**
      *  Constructor
      *  @param  data        pointer to the data
      *  @param  escaper     the escaper to use for the printed variables
      */
-    Handler(const Data *data, const Escaper *escaper) : _data(data), _encoder(escaper)
-    {
-        // we reserve some space in the output buffer, so that it is not
-        // necessary to reallocate all the time (which is slow)
-        _buffer.reserve(4096);
-    }
+    Handler(const Data *data, const Escaper *escaper) :
+        _buffer(4096), _data(data), _encoder(escaper),
+        _caching(data->resolving() && data->caching()) {}
 
     /**
      *  Destructor
@@ -123,6 +205,25 @@ public:
         _buffer.append(buffer, size);
     }
 
+    /**
+     *  Make sure that the output buffer has room for a number of bytes
+     *  @param  size
+     */
+    void reserve(size_t size)
+    {
+        _buffer.reserve(size);
+    }
+
+    /**
+     *  Access to the output buffer, so that the generated code can write
+     *  into it directly
+     *  @return OutputBuffer
+     */
+    OutputBuffer *buffer()
+    {
+        return &_buffer;
+    }
+
     /**
      *  Output the Value object and most importantly, encode it if needed
      *  @param  value
@@ -130,6 +231,20 @@ public:
      */
     void output(const Value *value, bool escape)
     {
+        // the string of a pipeline does not have to be copied if it is not escaped
+        if (!escape && typeid(*value) == typeid(BufferValue)) return _buffer.append(static_cast<const BufferValue *>(value)->buffer());
+
+        // string callbacks write into a buffer that we reuse
+        if (typeid(*value) == typeid(StringCallbackValue))
+        {
+            // let the callback fill the buffer
+            _scratch.clear();
+            static_cast<const StringCallbackValue *>(value)->write(_scratch);
+
+            // and output it
+            return output(_scratch, escape);
+        }
+
         // Turn the value into a string
         std::string work = value->toString();
 
@@ -140,13 +255,37 @@ public:
         _buffer.append(work);
     }
 
+    /**
+     *  Output a string that is no longer needed, so that it can be escaped
+     *  in place
+     *  @param  work
+     *  @param  escape
+     */
+    void output(std::string &work, bool escape)
+    {
+        // Should we escape the value?
+        if (escape) _encoder->encode(work);
+
+        // Append it to our buffer
+        _buffer.append(work);
+    }
+
     /**
      *  Output a numeric value
      *  @param  number   The numberic value to output
      */
     void outputNumeric(numeric_t number)
     {
-        _buffer.append(std::to_string(number));
+        _buffer.append(number);
+    }
+
+    /**
+     *  Output a floating point value
+     *  @param  number   The floating point value to output
+     */
+    void outputDouble(double number)
+    {
+        _buffer.append(DoubleValue(number).toString());
     }
 
     /**
@@ -155,23 +294,93 @@ public:
      *  @param  size
      *  @return Value
      */
-    const Value *variable(const char *name, size_t size) const
+    const Value *variable(const char *name, size_t size)
     {
         // look through our local values first
         auto iter = _local_values.find(name);
         if (iter != _local_values.end()) return iter->second;
 
-        // didn't find it? get the variable from the data object
-        return _data->value(name, size);
+        // perhaps the variable was already resolved
+        if (_caching)
+        {
+            // check the variables that were resolved on demand
+            auto found = _resolved.find(name);
+            if (found != _resolved.end()) return found->second;
+        }
+
+        // didn't find it? get the variable from the data object, which might call a resolver
+        auto *value = _data->value(name, size);
+        if (!value)
+        {
+            // remember that the variable does not exist
+            if (_caching) _resolved[name] = nullptr;
+
+            // not found
+            return nullptr;
+        }
+
+        // callbacks might have to be called only once during this run
+        if (typeid(*value) == typeid(CallbackValue)) value = memoize(static_cast<const CallbackValue *>(value));
+
+        // remember the value
+        if (_caching) _resolved[name] = value;
+
+        // done
+        return value;
+    }
+
+    /**
+     *  The value of a callback variable, which is only called once during this
+     *  run if the value may be cached for the duration of a process call
+     *  @param  callback    The callback variable
+     *  @return const Value*
+     */
+    const Value *memoize(const CallbackValue *callback)
+    {
+        // other callbacks are called every time the value is used
+        return callback->memoized() ? evaluate(callback) : callback;
+    }
+
+    /**
+     *  Call a callback once during this run, and keep its value until the end
+     *  of the run
+     *  @param  callback    The callback variable
+     *  @return const Value*
+     */
+    const Value *evaluate(const CallbackValue *callback)
+    {
+        // perhaps the callback was already called
+        auto iter = _memoized.find(callback);
+        if (iter != _memoized.end()) return iter->second;
+
+        // call the callback, and keep the value until the end of the run
+        return _memoized[callback] = manage(callback->call());
+    }
+
+    /**
+     *  The value to use when the members of a variable are accessed. If the
+     *  variable is a callback, it is called only once during this run, no
+     *  matter how often its members are accessed
+     *  @param  value       The variable
+     *  @return const Value*
+     */
+    const Value *structure(const Value *value)
+    {
+        // only callbacks have to be evaluated
+        if (typeid(*value) != typeid(CallbackValue)) return value;
+
+        // callbacks that cache their value forever are evaluated only once anyway
+        auto *callback = static_cast<const CallbackValue *>(value);
+        return callback->cacheable() ? callback : evaluate(callback);
     }
 
     /**
      *  Return the generated output
      *  @return std::string
      */
-    const std::string &output() const
+    std::string output() const
     {
-        return _buffer;
+        return _buffer.str();
     }
 
     /**
@@ -194,22 +403,28 @@ public:
      */
     void assign(const char *key, size_t key_size, VariantValue value)
     {
-        VariantValue *copy = new VariantValue(std::move(value));
-        manageValue(copy);
-        _local_values[key] = copy;
+        invalidate(key);
+        _local_values[key] = manage(std::move(value));
     }
 
     /**
-     *  Assign a just allocated Value to a specify key
+     *  Assign a value that was looked up or computed by the template to a
+     *  local variable. The value is owned by someone else, but it could be
+     *  (a member of) a loop variable that is overwritten on the next
+     *  iteration, so variants are copied, which is cheap because their
+     *  members are shared. Other values are bound without being copied.
      *
      *  @param  key         The name of our local variable
      *  @param  key_size    The size of key
-     *  @param  value       The newly allocated value we would like to assign
+     *  @param  value       The value we would like to assign
      */
     void assign(const char *key, size_t key_size, const Value *value)
     {
-        manageValue(value);
-        _local_values[key] = value;
+        // variants are copied
+        if (typeid(*value) == typeid(VariantValue)) return assign(key, key_size, *static_cast<const VariantValue *>(value));
+
+        // other values are bound
+        bind(key, key_size, value);
     }
 
     /**
@@ -257,27 +472,198 @@ public:
     }
 
     /**
-     *  Make this value object managed by the handler
-     *  @param  value    The value object to make managed
-     *  @return True if we created a new shared pointer
+     *  Give a loop variable the value of the next iteration, the value is
+     *  stored in the object that holds the variable during the entire run,
+     *  so that memory does not grow with the number of iterations
+     *  @param  key         The name of the loop variable
+     *  @param  key_size    The size of key
+     *  @param  value       The new value
+     */
+    void step(const char *key, size_t key_size, VariantValue &&value)
+    {
+        store(_loop_values, key, std::move(value));
+    }
+
+    /**
+     *  Give a loop variable the numeric value of the next iteration
+     *  @param  key         The name of the loop variable
+     *  @param  key_size    The size of key
+     *  @param  value       The new value
+     */
+    void step(const char *key, size_t key_size, numeric_t value)
+    {
+        step(key, key_size, VariantValue(value));
+    }
+
+    /**
+     *  Turn the counter of a for loop into a variable, the value is stored in
+     *  the same object every time, so that no memory is allocated per iteration
+     *  @param  key         The name of the counter
+     *  @param  key_size    The size of key
+     *  @param  value       The current value of the counter
+     *  @return const Value*
+     */
+    const Value *counter(const char *key, size_t key_size, numeric_t value)
+    {
+        return store(_counter_values, key, VariantValue(value));
+    }
+
+    /**
+     *  Bind a value that is owned by someone else to a local variable
+     *  @param  key         The name of our local variable
+     *  @param  key_size    The size of key
+     *  @param  value       The value
+     */
+    void bind(const char *key, size_t key_size, const Value *value)
+    {
+        invalidate(key);
+        _local_values[key] = value;
+    }
+
+    /**
+     *  Retrieve the value of a path that was already resolved
+     *  @param  index       The slot of the path
+     *  @return const Value*    nullptr if the path was not yet resolved
+     */
+    const Value *slot(size_t index) const
+    {
+        return index < _slots.size() ? _slots[index] : nullptr;
+    }
+
+    /**
+     *  Store the value of a path that was resolved
+     *  @param  index       The slot of the path
+     *  @param  name        Name of the variable where the path starts
+     *  @param  value       The value at the end of the path
+     */
+    void slot(size_t index, const char *name, const Value *value)
+    {
+        // make sure that the slot exists
+        if (index >= _slots.size()) _slots.resize(index + 1, nullptr);
+
+        // store the value
+        _slots[index] = value;
+
+        // remember the variable that it depends on
+        _filled[name].push_back(index);
+    }
+
+    /**
+     *  Forget the paths that start with a certain variable, because the
+     *  variable is going to be assigned
+     *  @param  name        Name of the variable
+     */
+    void invalidate(const char *name)
+    {
+        // find the slots that depend on the variable
+        auto iter = _filled.find(name);
+        if (iter == _filled.end()) return;
+
+        // empty the slots
+        for (auto index : iter->second) _slots[index] = nullptr;
+
+        // forget them, but keep the memory for when they are filled again
+        iter->second.clear();
+    }
+
+    /**
+     *  Turn a variant into a value object that lives until the handler is
+     *  destructed. Null and boolean values are not copied, but one of the
+     *  shared instances is returned for them
+     *  @param  value    The value to store
+     *  @return const Value*
+     */
+    const Value *manage(VariantValue &&value)
+    {
+        // use a shared instance if there is one
+        auto *result = Immortal::find(value);
+        if (result) return result;
+
+        // allocate a copy, and make it managed
+        result = new VariantValue(std::move(value));
+        _managed_local_values.emplace_back(result);
+
+        // done
+        return result;
+    }
+
+    /**
+     *  The string of a pipeline of string modifiers, if the value is one that
+     *  is still open. These buffers are only created by the handler itself, so
+     *  the next modifier of the pipeline is allowed to change them
+     *  @param  value    The value
+     *  @return BufferValue*
      */
-    bool manageValue(const Value *value)
+    BufferValue *pipeline(const Value *value) const
     {
-        // Check if someone is already managing value or not
-        for (auto &v : _managed_local_values)
+        // check the type of the value
+        if (typeid(*value) != typeid(BufferValue)) return nullptr;
+
+        // we own the buffer, so we can modify it
+        auto *buffer = const_cast<BufferValue *>(static_cast<const BufferValue *>(value));
+
+        // only if it is still open
+        return buffer->open() ? buffer : nullptr;
+    }
+
+    /**
+     *  Create the string for a pipeline of string modifiers, that lives until
+     *  the handler is destructed, or until it is recycled
+     *  @param  value    The string
+     *  @param  open     Can the next modifier change it?
+     *  @return BufferValue*
+     */
+    BufferValue *pipeline(std::string &&value, bool open)
+    {
+        // reuse the buffer of a pipeline that was finished
+        if (!_buffers.empty())
         {
-            // In case we found it that means that we are already managed
-            if (v.get() == value) return false;
+            // take it from the list
+            auto *result = _buffers.back();
+            _buffers.pop_back();
+
+            // store the string
+            result->reset(std::move(value), open);
+            return result;
         }
 
-        // if it is already hold by the data object we also do not have to manage it
-        if (_data->contains(value)) return false;
+        // allocate the buffer, and make it managed
+        auto *result = new BufferValue(std::move(value), open);
+        _managed_local_values.emplace_back(result);
 
-        // If they are not we start managing it
-        _managed_local_values.emplace_back(value);
+        // done
+        return result;
+    }
+
+    /**
+     *  Recycle the string of a pipeline that was still open, and that is no
+     *  longer needed. Open buffers are only passed from one modifier to the
+     *  next, so no one else can refer to it
+     *  @param  buffer   The buffer
+     */
+    void recycle(BufferValue *buffer)
+    {
+        // forget the string that might have been made of it
+        _managed_strings.erase(buffer);
+
+        // the next pipeline can use it
+        _buffers.push_back(buffer);
+    }
+
+    /**
+     *  Close the pipeline of string modifiers, if the value is the string of
+     *  one, because the value is going to be used elsewhere
+     *  @param  value    The value
+     *  @return const Value*    The same value
+     */
+    const Value *close(const Value *value) const
+    {
+        // close the buffer if it is one
+        auto *buffer = pipeline(value);
+        if (buffer) buffer->close();
 
-        // Return true to indicate that we are now managing value
-        return true;
+        // done
+        return value;
     }
 
     /**
@@ -0,0 +1,27 @@
+/**
+ *  Immortal.cpp
+ *
+ *  The process wide null, true and false values
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  The instances, these are stored inline in the variant, so they never
+ *  touch a reference counter
+ */
+const VariantValue Immortal::_null;
+const VariantValue Immortal::_true(true);
+const VariantValue Immortal::_false(false);
+
+/**
+ *  End namespace
+ */
+}}
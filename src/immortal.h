@@ -0,0 +1,82 @@
+/**
+ *  Immortal.h
+ *
+ *  Process wide instances of the null, true and false values. Templates use
+ *  these values all the time (every missing variable or member is null, and
+ *  every comparison results in a boolean), so instead of allocating a new
+ *  object every time, the callbacks hand out pointers to these instances.
+ *  They are never modified and never destructed by a handler, so they can
+ *  safely be shared by all threads.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class Immortal
+{
+private:
+    /**
+     *  The shared instances
+     *  @var    VariantValue
+     */
+    static const VariantValue _null;
+    static const VariantValue _true;
+    static const VariantValue _false;
+
+public:
+    /**
+     *  The null value
+     *  @return const Value*
+     */
+    static const Value *null()
+    {
+        return &_null;
+    }
+
+    /**
+     *  The boolean values
+     *  @param  value
+     *  @return const Value*
+     */
+    static const Value *boolean(bool value)
+    {
+        return value ? &_true : &_false;
+    }
+
+    /**
+     *  Find the shared instance that holds the same value as a variant
+     *  @param  value
+     *  @return const Value*        nullptr if there is no such instance
+     */
+    static const Value *find(const VariantValue &value)
+    {
+        switch (value.type()) {
+        case Value::Type::Null: return null();
+        case Value::Type::Bool: return boolean(value.toBoolean());
+        default:                return nullptr;
+        }
+    }
+
+    /**
+     *  Is a value one of the shared instances?
+     *  @param  value
+     *  @return bool
+     */
+    static bool contains(const Value *value)
+    {
+        return value == &_null || value == &_true || value == &_false;
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
@@ -28,6 +28,13 @@
 #include <ctime>
 #include <boost/regex.hpp>
 #include <iomanip>
+#include <mutex>
+#include <cerrno>
+#include <cstdlib>
+#include <typeinfo>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <openssl/md5.h>
 #include <openssl/sha.h>
 #include <openssl/bio.h>
@@ -58,6 +65,7 @@
 #include "include/callbacks.h"
 #include "include/parameters.h"
 #include "include/modifier.h"
+#include "include/stringmodifier.h"
 #include "include/data.h"
 #include "include/template.h"
 #include "include/compileerror.h"
@@ -73,9 +81,16 @@
  */
 #include "token.h"
 #include "quotedstring.h"
+#include "path.h"
+#include "invariants.h"
 #include "generator.h"
 #include "escaper.h"
 #include "callbackvalue.h"
+#include "scalarcallbackvalue.h"
+#include "stringcallbackvalue.h"
+#include "slicevalue.h"
+#include "buffervalue.h"
+#include "jsonvalue.h"
 #include "dynamic/openssl.h"
 #include "escapers/null.h"
 #include "escapers/html.h"
@@ -111,18 +126,19 @@
 #include "builtin/base64encode.h"
 #include "builtin/base64decode.h"
 #include "builtin/range.h"
+#include "builtins.h"
 #include "modifiers/parameters.h"
 #include "modifiers/modifierexpression.h"
 #include "modifiers/modifiers.h"
 #include "expressions/expression.h"
+#include "expressions/literal.h"
+#include "expressions/literalnumeric.h"
 #include "expressions/variable.h"
 #include "expressions/literalvariable.h"
 #include "expressions/arrayaccess.h"
 #include "expressions/literalarrayaccess.h"
 #include "expressions/variablearrayaccess.h"
-#include "expressions/literal.h"
 #include "expressions/literalboolean.h"
-#include "expressions/literalnumeric.h"
 #include "expressions/literaldouble.h"
 #include "expressions/literalstring.h"
 #include "expressions/filter.h"
@@ -133,6 +149,7 @@
 #include "statements/expression.h"
 #include "statements/if.h"
 #include "statements/foreach.h"
+#include "statements/for.h"
 #include "statements/assign.h"
 #include "operators/operator.h"
 #include "operators/binary.h"
@@ -152,6 +169,8 @@
 #include "operators/binaryboolean.h"
 #include "operators/binaryand.h"
 #include "operators/binaryor.h"
+#include "expressions/loopcounter.h"
+#include "expressions/loopproperty.h"
 #include "signature_callback.h"
 #include "tokenprocessor.h"
 #include "parser.h"
@@ -161,10 +180,18 @@
 #include "ccode.h"
 #include "callbacks.h"
 #include "iterator.h"
+#include "immortal.h"
+#include "outputbuffer.h"
 #include "handler.h"
 #include "executor.h"
 #include "jit_exception.h"
 #include "bytecode.h"
+#include "sharedlibrary.h"
 #include "library.h"
 #include "vector_iterator.h"
 #include "map_iterator.h"
+#include "slice_iterator.h"
+#include "generator_iterator.h"
+#include "callback_iterator.h"
+#include "json_iterator.h"
+#include "generatorvalue.h"
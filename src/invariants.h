@@ -0,0 +1,139 @@
+/**
+ *  Invariants.h
+ *
+ *  Helper class to find the variables inside the body of a foreach loop that
+ *  do not change from one iteration to the next. These are the variables that
+ *  do not depend on the key and value of the loop, or on other names that are
+ *  assigned inside the loop, so that they can be evaluated once before the
+ *  loop starts. Only the variables that are evaluated on every iteration
+ *  qualify: variables inside an {if} branch, inside a nested loop or on the
+ *  right side of && and || might never be evaluated at all, and evaluating
+ *  them anyway could call resolvers, callbacks and modifiers for nothing.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Forwards
+ */
+class Variable;
+
+/**
+ *  Class definition
+ */
+class Invariants
+{
+private:
+    /**
+     *  Names that get a new value inside the loop
+     *  @var    std::set
+     */
+    std::set<std::string> _bound;
+
+    /**
+     *  Variables that could be evaluated before the loop, with the names
+     *  that they depend on
+     *  @var    std::vector
+     */
+    std::vector<std::pair<const Variable *, std::set<std::string>>> _candidates;
+
+    /**
+     *  Number of conditional parts of the body that we are in
+     *  @var    size_t
+     */
+    size_t _conditional = 0;
+
+public:
+    /**
+     *  Constructor
+     *  @param  key         name of the key variable of the loop (can be empty)
+     *  @param  value       name of the value variable of the loop
+     */
+    Invariants(const std::string &key, const std::string &value)
+    {
+        // the key and value get a new value every iteration
+        bind(key);
+        bind(value);
+    }
+
+    /**
+     *  Destructor
+     */
+    virtual ~Invariants() {}
+
+    /**
+     *  Register a name that gets a new value inside the loop
+     *  @param  name
+     */
+    void bind(const std::string &name)
+    {
+        // empty names are not used
+        if (!name.empty()) _bound.insert(name);
+    }
+
+    /**
+     *  Does a name get a new value inside the loop?
+     *  @param  name
+     *  @return bool
+     */
+    bool bound(const std::string &name) const
+    {
+        return _bound.find(name) != _bound.end();
+    }
+
+    /**
+     *  Enter and leave a part of the body that is not executed on every
+     *  iteration, the names that are assigned in it are still registered
+     */
+    void enter() { ++_conditional; }
+    void leave() { --_conditional; }
+
+    /**
+     *  Register a variable that could be evaluated before the loop
+     *  @param  variable    the variable
+     *  @param  names       the names that it depends on
+     */
+    void candidate(const Variable *variable, std::set<std::string> &&names)
+    {
+        // variables that are not always evaluated are left alone
+        if (_conditional == 0) _candidates.emplace_back(variable, std::move(names));
+    }
+
+    /**
+     *  The variables that do not change inside the loop, this can only be
+     *  called after the entire body was processed, because names can also
+     *  be assigned after they are used
+     *  @return std::vector
+     */
+    std::vector<const Variable *> variables() const
+    {
+        // the result
+        std::vector<const Variable *> result;
+
+        // check all candidates
+        for (auto &candidate : _candidates)
+        {
+            // check if the variable depends on a name that changes
+            bool invariant = std::none_of(candidate.second.begin(), candidate.second.end(), [this](const std::string &name) {
+                return bound(name);
+            });
+
+            // add it if it does not
+            if (invariant) result.push_back(candidate.first);
+        }
+
+        // done
+        return result;
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
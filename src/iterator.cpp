@@ -0,0 +1,45 @@
+/**
+ *  Iterator.cpp
+ *
+ *  Default implementation of the method to fetch elements from an iterator
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl {
+
+/**
+ *  Fetch the next element, and move past it. Iterators that do not override
+ *  this method were written before elements were fetched in batches, and
+ *  they might produce their elements on demand, so only one element is
+ *  fetched at a time
+ *  @param  keys        Array in which the keys should be stored, or nullptr if the keys are not needed
+ *  @param  values      Array in which the values should be stored
+ *  @param  max         Size of the arrays
+ *  @return size_t      Number of elements that were fetched
+ */
+size_t Iterator::fetch(VariantValue *keys, VariantValue *values, size_t max)
+{
+    // check if we're at the end
+    if (max == 0 || !valid()) return 0;
+
+    // store the key and the value
+    if (keys) keys[0] = key();
+    values[0] = value();
+
+    // move on to the next element
+    next();
+
+    // one element was fetched
+    return 1;
+}
+
+/**
+ *  End namespace
+ */
+}
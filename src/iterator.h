@@ -23,6 +23,14 @@ namespace SmartTpl { namespace Internal {
 class Iterator
 {
 private:
+    /**
+     *  Copy of the source, if it is a variant. Loop variables are overwritten
+     *  on every iteration, so if the source is (a member of) one, the copy
+     *  keeps the members that we iterate over alive
+     *  @var    VariantValue
+     */
+    VariantValue _source;
+
     /**
      *  Iterator
      *
@@ -30,13 +38,35 @@ private:
      */
     std::unique_ptr<SmartTpl::Iterator> _iterator;
 
+    /**
+     *  Max number of elements that are fetched from the iterator at once,
+     *  iterators that do not override fetch() return only one at a time
+     *  @var    size_t
+     */
+    static const size_t batchSize = 16;
+
+    /**
+     *  The keys and values of the batch that was fetched last
+     *  @var    std::vector
+     */
+    std::vector<VariantValue> _keys;
+    std::vector<VariantValue> _values;
+
+    /**
+     *  Position of the current element in the batch, and number of elements in it
+     *  @var    size_t
+     */
+    size_t _position = 0;
+    size_t _size = 0;
+
 public:
     /**
      *  Constructor
      *  @param  source      The source value object to iterate over
      */
     Iterator(const Value *source) :
-        _iterator(source->iterator()) {}
+        _source(typeid(*source) == typeid(VariantValue) ? *static_cast<const VariantValue *>(source) : VariantValue()),
+        _iterator((typeid(*source) == typeid(VariantValue) ? &_source : source)->iterator()) {}
 
     /**
      *  Destructor
@@ -88,6 +118,47 @@ public:
         // increment position
         _iterator->next();
     }
+
+    /**
+     *  Move to the next element, using the batch interface of the iterator,
+     *  the first call moves to the first element. This should not be mixed
+     *  with the valid()/key()/value()/next() methods.
+     *  @param  keys        Are the keys needed?
+     *  @return bool        False when the end was reached
+     */
+    bool fetch(bool keys)
+    {
+        // move to the next element in the batch, if there is one we're done
+        if (++_position < _size) return true;
+
+        // there is nothing to fetch if there is no iterator
+        if (!_iterator) return false;
+
+        // allocate the arrays the first time that we're called
+        if (_values.empty()) _values.resize(batchSize);
+        if (keys && _keys.empty()) _keys.resize(batchSize);
+
+        // fetch a new batch
+        _size = _iterator->fetch(keys ? _keys.data() : nullptr, _values.data(), batchSize);
+        _position = 0;
+
+        // was something fetched?
+        return _size > 0;
+    }
+
+    /**
+     *  The key and value of the element that was fetched, these can be
+     *  moved out of the batch, as they are only used once
+     *  @return VariantValue
+     */
+    VariantValue &fetchedKey()
+    {
+        return _keys[_position];
+    }
+    VariantValue &fetchedValue()
+    {
+        return _values[_position];
+    }
 };
 
 /**
@@ -0,0 +1,119 @@
+/**
+ *  Json_Iterator.h
+ *
+ *  Iterator over the members of a JSON object or array. The members are
+ *  only converted into values when the iterator reaches them.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class JsonIterator : public SmartTpl::Iterator
+{
+private:
+    /**
+     *  The object or array that we iterate over
+     *  @var    const JsonValue*
+     */
+    const JsonValue *_value;
+
+    /**
+     *  The current position
+     *  @var    size_t
+     */
+    size_t _position = 0;
+
+    /**
+     *  Number of members
+     *  @var    size_t
+     */
+    const size_t _size;
+
+public:
+    /**
+     *  Constructor
+     *
+     *  The iterator refers to the JSON value, so it should stay valid for as
+     *  long as the iterator is in use. The handler keeps the iterated values
+     *  alive during the entire run of a template.
+     *
+     *  @param  value       The object or array to iterate over
+     */
+    JsonIterator(const JsonValue *value) : _value(value), _size(value->memberCount()) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~JsonIterator() {}
+
+    /**
+     *  Check if the iterator is still valid
+     *  @return bool
+     */
+    bool valid() const override
+    {
+        return _position < _size;
+    }
+
+    /**
+     *  Move to the next position
+     */
+    void next() override
+    {
+        ++_position;
+    }
+
+    /**
+     *  Retrieve pointer to the current member
+     *  @return Variant
+     */
+    VariantValue value() const override
+    {
+        return _value->member(_position);
+    }
+
+    /**
+     *  Retrieve a pointer to the current key
+     *  @return Variant
+     */
+    VariantValue key() const override
+    {
+        return _value->key(_position);
+    }
+
+    /**
+     *  Fetch a number of elements at once, and move past them
+     *  @param  keys        Array for the keys, or nullptr
+     *  @param  values      Array for the values
+     *  @param  max         Size of the arrays
+     *  @return size_t      Number of elements that were fetched
+     */
+    size_t fetch(VariantValue *keys, VariantValue *values, size_t max) override
+    {
+        // number of elements that were fetched
+        size_t count = 0;
+
+        // the members are already in memory, so we fill the entire batch
+        for (; count < max && _position < _size; ++count, ++_position)
+        {
+            if (keys) keys[count] = _value->key(_position);
+            values[count] = _value->member(_position);
+        }
+
+        // done
+        return count;
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
@@ -0,0 +1,438 @@
+/**
+ *  JsonValue.cpp
+ *
+ *  Implementation of the lazy JSON value, the JSON text is scanned without
+ *  being copied, and scalars are only converted when they are accessed
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Helper function to skip whitespace
+ *  @param  pos         Current position
+ *  @param  end         End of the buffer
+ *  @return const char* The first position that is not whitespace
+ */
+static const char *whitespace(const char *pos, const char *end)
+{
+    // skip the characters that json considers whitespace
+    while (pos < end && (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t')) ++pos;
+
+    // done
+    return pos;
+}
+
+/**
+ *  Helper function to skip a string
+ *  @param  pos         Position of the opening quote
+ *  @param  end         End of the buffer
+ *  @return const char* Position after the closing quote, or nullptr if there is none
+ */
+static const char *skipString(const char *pos, const char *end)
+{
+    // look for the closing quote, escaped characters are skipped
+    for (++pos; pos < end; ++pos)
+    {
+        if (*pos == '"') return pos + 1;
+        if (*pos == '\\') ++pos;
+    }
+
+    // the string was not closed
+    return nullptr;
+}
+
+/**
+ *  Helper function to skip a value, objects and arrays are skipped by only
+ *  looking at the brackets and the strings inside them
+ *  @param  pos         Start of the value
+ *  @param  end         End of the buffer
+ *  @return const char* Position after the value, or nullptr if it is malformed
+ */
+static const char *skipValue(const char *pos, const char *end)
+{
+    // strings
+    if (*pos == '"') return skipString(pos, end);
+
+    // objects and arrays
+    if (*pos == '{' || *pos == '[')
+    {
+        // the nesting depth
+        size_t depth = 0;
+
+        // look for the closing bracket
+        while (pos < end)
+        {
+            switch (*pos) {
+            case '"':   pos = skipString(pos, end); if (!pos) return nullptr; continue;
+            case '{':   // fall through
+            case '[':   ++depth; break;
+            case '}':   // fall through
+            case ']':   if (--depth == 0) return pos + 1; break;
+            }
+
+            // next character
+            ++pos;
+        }
+
+        // the object or array was not closed, the index stops where the text is malformed
+        return end;
+    }
+
+    // numbers, booleans and null end at the next delimiter
+    auto *begin = pos;
+    while (pos < end && !strchr(",:}] \n\r\t", *pos)) ++pos;
+
+    // empty values are malformed
+    return pos > begin ? pos : nullptr;
+}
+
+/**
+ *  Helper function to append a code point to a string as utf-8
+ *  @param  result      The string to append to
+ *  @param  code        The code point
+ */
+static void utf8(std::string &result, unsigned long code)
+{
+    if (code < 0x80)
+    {
+        result.push_back(code);
+    }
+    else if (code < 0x800)
+    {
+        result.push_back(0xC0 | (code >> 6));
+        result.push_back(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000)
+    {
+        result.push_back(0xE0 | (code >> 12));
+        result.push_back(0x80 | ((code >> 6) & 0x3F));
+        result.push_back(0x80 | (code & 0x3F));
+    }
+    else
+    {
+        result.push_back(0xF0 | (code >> 18));
+        result.push_back(0x80 | ((code >> 12) & 0x3F));
+        result.push_back(0x80 | ((code >> 6) & 0x3F));
+        result.push_back(0x80 | (code & 0x3F));
+    }
+}
+
+/**
+ *  Helper function to parse the four hexadecimal digits of a \u escape
+ *  @param  pos         Position of the digits
+ *  @param  end         End of the string
+ *  @return unsigned long   The code, or 0xFFFD if the digits are malformed
+ */
+static unsigned long hex(const char *pos, const char *end)
+{
+    // there should be four digits
+    if (end - pos < 4) return 0xFFFD;
+
+    // parse them
+    char digits[5] = { pos[0], pos[1], pos[2], pos[3], 0 };
+    char *last = nullptr;
+    unsigned long code = strtoul(digits, &last, 16);
+
+    // all of them should be digits
+    return last == digits + 4 ? code : 0xFFFD;
+}
+
+/**
+ *  Helper function to replace the escape sequences in a string
+ *  @param  pos         Start of the string, without the quote
+ *  @param  end         End of the string, without the quote
+ *  @return std::string
+ */
+static std::string unescape(const char *pos, const char *end)
+{
+    // the result, it will not be longer than the input
+    std::string result;
+    result.reserve(end - pos);
+
+    // process all characters
+    for (; pos < end; ++pos)
+    {
+        // normal characters are copied
+        if (*pos != '\\') { result.push_back(*pos); continue; }
+
+        // skip the backslash
+        if (++pos == end) break;
+
+        // check the escaped character
+        switch (*pos) {
+        case 'b':   result.push_back('\b'); break;
+        case 'f':   result.push_back('\f'); break;
+        case 'n':   result.push_back('\n'); break;
+        case 'r':   result.push_back('\r'); break;
+        case 't':   result.push_back('\t'); break;
+        case 'u':   {
+            // the code of the character
+            auto code = hex(pos + 1, end);
+            pos += std::min<size_t>(4, end - pos - 1);
+
+            // characters outside the basic plane are written as a surrogate pair
+            if (code >= 0xD800 && code < 0xDC00 && end - pos > 6 && pos[1] == '\\' && pos[2] == 'u')
+            {
+                // the second half of the pair
+                auto low = hex(pos + 3, end);
+                if (low >= 0xDC00 && low < 0xE000)
+                {
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    pos += 6;
+                }
+            }
+
+            // append the character
+            utf8(result, code);
+            break;
+        }
+        default:    result.push_back(*pos); break;
+        }
+    }
+
+    // done
+    return result;
+}
+
+/**
+ *  Helper function to convert the JSON text of a value
+ *  @param  json        The buffer that holds the JSON text
+ *  @param  begin       Start of the JSON text
+ *  @param  end         End of the JSON text
+ *  @return VariantValue
+ */
+static VariantValue convert(const std::shared_ptr<const std::string> &json, const char *begin, const char *end)
+{
+    switch (*begin) {
+    case '"':   {
+        // the text between the quotes (skipString made sure there is a closing quote)
+        const char *text = begin + 1;
+        size_t size = end - begin - 2;
+
+        // strings without escape sequences can be copied right away
+        if (!memchr(text, '\\', size)) return VariantValue(text, size);
+
+        // replace the escape sequences
+        return unescape(text, text + size);
+    }
+    case '{':   // fall through
+    case '[':   return std::shared_ptr<Value>(std::make_shared<JsonValue>(json, begin, end));
+    case 't':   return true;
+    case 'f':   return false;
+    case 'n':   return nullptr;
+    }
+
+    // this is a number, it is a floating point number if it has a fraction or an exponent
+    for (auto *pos = begin; pos < end; ++pos)
+    {
+        if (*pos == '.' || *pos == 'e' || *pos == 'E') return strtod(begin, nullptr);
+    }
+
+    // integral number (the buffer is zero terminated, so this does not run past it)
+    return (numeric_t)strtoll(begin, nullptr, 10);
+}
+
+/**
+ *  Turn a JSON buffer into a value
+ *  @param  json        The JSON text
+ *  @return VariantValue
+ */
+VariantValue JsonValue::parse(std::string &&json)
+{
+    // the buffer will be shared by all objects and arrays inside it
+    auto buffer = std::make_shared<const std::string>(std::move(json));
+
+    // the text of the value
+    auto *end = buffer->data() + buffer->size();
+    auto *begin = whitespace(buffer->data(), end);
+
+    // empty buffers are null
+    if (begin == end) return nullptr;
+
+    // find the end of the value
+    auto *last = skipValue(begin, end);
+    if (!last) return nullptr;
+
+    // convert the value
+    return convert(buffer, begin, last);
+}
+
+/**
+ *  Index the members
+ */
+void JsonValue::build() const
+{
+    // is this an object or an array?
+    bool object = *_begin == '{';
+
+    // the position of the first member
+    auto *pos = whitespace(_begin + 1, _end);
+
+    // scan the members, until the end or until the json is malformed
+    while (pos < _end && *pos != '}' && *pos != ']')
+    {
+        // the new member
+        Entry entry{ nullptr, 0, false, nullptr, nullptr, nullptr };
+
+        // members of objects start with a key
+        if (object)
+        {
+            // find the end of the key
+            if (*pos != '"') break;
+            auto *key = skipString(pos, _end);
+            if (!key) break;
+
+            // store the key without the quotes
+            entry.key = pos + 1;
+            entry.keysize = key - pos - 2;
+            entry.escaped = memchr(entry.key, '\\', entry.keysize) != nullptr;
+
+            // the key is followed by a colon
+            pos = whitespace(key, _end);
+            if (pos == _end || *pos != ':') break;
+            pos = whitespace(pos + 1, _end);
+            if (pos == _end) break;
+        }
+
+        // find the end of the value
+        entry.begin = pos;
+        entry.end = skipValue(pos, _end);
+        if (!entry.end) break;
+
+        // nested objects and arrays are created once, so that their index is kept
+        if (*pos == '{' || *pos == '[') entry.child = std::make_shared<JsonValue>(_json, entry.begin, entry.end);
+
+        // store the member
+        _index.push_back(std::move(entry));
+
+        // members are separated by commas
+        pos = whitespace(_index.back().end, _end);
+        if (pos == _end || *pos != ',') break;
+        pos = whitespace(pos + 1, _end);
+    }
+
+    // small objects and arrays are searched without an index
+    if (!object || _index.size() <= threshold) return;
+
+    // index the names, the first member wins if a name is used more than once
+    for (size_t i = 0; i < _index.size(); ++i)
+    {
+        auto &entry = _index[i];
+        _names.emplace(entry.escaped ? unescape(entry.key, entry.key + entry.keysize) : std::string(entry.key, entry.keysize), i);
+    }
+}
+
+/**
+ *  Get the value of a member
+ *  @param  entry       The member
+ *  @return VariantValue
+ */
+VariantValue JsonValue::value(const Entry &entry) const
+{
+    // nested objects and arrays were already created
+    if (entry.child) return entry.child;
+
+    // convert the scalar
+    return convert(_json, entry.begin, entry.end);
+}
+
+/**
+ *  Get access to a member value
+ *  @param  name        name of the member
+ *  @param  size        size of the name
+ *  @return VariantValue
+ */
+VariantValue JsonValue::member(const char *name, size_t size) const
+{
+    // the members
+    auto &entries = index();
+
+    // large objects are indexed by name
+    if (!_names.empty())
+    {
+        // look up the position
+        auto iter = _names.find(std::string(name, size));
+        return iter == _names.end() ? VariantValue(nullptr) : value(entries[iter->second]);
+    }
+
+    // look through the members
+    for (auto &entry : entries)
+    {
+        // keys with escape sequences have to be compared after replacing them
+        if (entry.escaped)
+        {
+            // compare the unescaped key
+            if (unescape(entry.key, entry.key + entry.keysize) != std::string(name, size)) continue;
+        }
+        else
+        {
+            // compare the key in the buffer
+            if (entry.keysize != size || memcmp(entry.key, name, size) != 0) continue;
+        }
+
+        // found it
+        return value(entry);
+    }
+
+    // not found
+    return nullptr;
+}
+
+/**
+ *  Get access to a member at a certain position
+ *  @param  position    Position of the item we want to retrieve
+ *  @return VariantValue
+ */
+VariantValue JsonValue::member(size_t position) const
+{
+    // the members
+    auto &entries = index();
+
+    // positions outside the object or array do not exist
+    if (position >= entries.size()) return nullptr;
+
+    // convert the member
+    return value(entries[position]);
+}
+
+/**
+ *  Get access to the key of a member at a certain position
+ *  @param  position    Position of the member
+ *  @return VariantValue
+ */
+VariantValue JsonValue::key(size_t position) const
+{
+    // the members
+    auto &entries = index();
+
+    // positions outside the object or array do not exist
+    if (position >= entries.size()) return nullptr;
+
+    // arrays use the position as key
+    auto &entry = entries[position];
+    if (!entry.key) return (numeric_t)position;
+
+    // return the name
+    return entry.escaped ? VariantValue(unescape(entry.key, entry.key + entry.keysize)) : VariantValue(entry.key, entry.keysize);
+}
+
+/**
+ *  Create a new iterator over the members
+ *  @return Iterator
+ */
+SmartTpl::Iterator *JsonValue::iterator() const
+{
+    return new JsonIterator(this);
+}
+
+/**
+ *  End namespace
+ */
+}}
@@ -0,0 +1,226 @@
+/**
+ *  JsonValue.h
+ *
+ *  An object or array inside a JSON buffer. Nothing is parsed when the value
+ *  is created: the first time the members are accessed, the members of this
+ *  level (and only this level) are indexed with a single scan over the
+ *  buffer. Nested objects and arrays are returned as JsonValue objects that
+ *  share the same buffer, these are created once when the level is indexed,
+ *  so their own index is kept as well. Scalars are converted when they are
+ *  accessed. Objects with many members also get an index by name.
+ *  Malformed JSON is not reported: the members before the error can be used
+ *  and everything after it is ignored.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class JsonValue : public Value
+{
+private:
+    /**
+     *  A member of the object or array
+     */
+    struct Entry
+    {
+        /**
+         *  The key, without the quotes (only used for objects)
+         *  @var    const char*
+         */
+        const char *key;
+
+        /**
+         *  Size of the key
+         *  @var    size_t
+         */
+        size_t keysize;
+
+        /**
+         *  Does the key contain escape sequences?
+         *  @var    bool
+         */
+        bool escaped;
+
+        /**
+         *  The JSON text of the value
+         *  @var    const char*
+         */
+        const char *begin;
+        const char *end;
+
+        /**
+         *  The nested object or array, if the value is one
+         *  @var    std::shared_ptr
+         */
+        std::shared_ptr<Value> child;
+    };
+
+    /**
+     *  Objects with more members than this are indexed by name
+     *  @var    size_t
+     */
+    static const size_t threshold = 16;
+
+    /**
+     *  The buffer that holds the JSON text
+     *  @var    std::shared_ptr
+     */
+    std::shared_ptr<const std::string> _json;
+
+    /**
+     *  The JSON text of this object or array, including the brackets
+     *  @var    const char*
+     */
+    const char *_begin;
+    const char *_end;
+
+    /**
+     *  The members, these are indexed the first time they are accessed, this
+     *  happens only once, even if the value is used by multiple threads
+     *  @var    std::vector
+     */
+    mutable std::vector<Entry> _index;
+    mutable std::once_flag _indexed;
+
+    /**
+     *  Positions of the members by name, only filled for large objects, it
+     *  is built together with the members
+     *  @var    std::map
+     */
+    mutable std::map<std::string, size_t> _names;
+
+    /**
+     *  Index the members
+     */
+    void build() const;
+
+    /**
+     *  Get the value of a member
+     *  @param  entry       The member
+     *  @return VariantValue
+     */
+    VariantValue value(const Entry &entry) const;
+
+    /**
+     *  Access to the members, they are indexed if this was not done before
+     *  @return std::vector
+     */
+    const std::vector<Entry> &index() const
+    {
+        // index the members once
+        std::call_once(_indexed, &JsonValue::build, this);
+
+        // expose the members
+        return _index;
+    }
+
+public:
+    /**
+     *  Constructor
+     *  @param  json        The buffer that holds the JSON text
+     *  @param  begin       Start of the object or array
+     *  @param  end         End of the object or array
+     */
+    JsonValue(const std::shared_ptr<const std::string> &json, const char *begin, const char *end) :
+        Value(*begin == '{' ? Type::Map : Type::Vector), _json(json), _begin(begin), _end(end) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~JsonValue() {}
+
+    /**
+     *  Turn a JSON buffer into a value, nothing is copied, and only scalars
+     *  at the top level are parsed right away
+     *  @param  json        The JSON text
+     *  @return VariantValue
+     */
+    static VariantValue parse(std::string &&json);
+
+    /**
+     *  The JSON text is used as string representation
+     *  @return std::string
+     */
+    std::string toString() const override
+    {
+        return std::string(_begin, _end - _begin);
+    }
+
+    /**
+     *  Convert the variable to a numeric value
+     *  @return numeric
+     */
+    numeric_t toNumeric() const override
+    {
+        return 0;
+    }
+
+    /**
+     *  Convert the variable to a boolean value
+     *  @return bool
+     */
+    bool toBoolean() const override
+    {
+        return memberCount() > 0;
+    }
+
+    /**
+     *  Convert the variable to a floating point value
+     *  @return double
+     */
+    double toDouble() const override
+    {
+        return 0.0;
+    }
+
+    /**
+     *  Get access to a member value
+     *  @param  name        name of the member
+     *  @param  size        size of the name
+     *  @return VariantValue
+     */
+    VariantValue member(const char *name, size_t size) const override;
+
+    /**
+     *  Get access to the amount of members this value has
+     *  @return size_t
+     */
+    size_t memberCount() const override
+    {
+        return index().size();
+    }
+
+    /**
+     *  Get access to a member at a certain position
+     *  @param  position    Position of the item we want to retrieve
+     *  @return VariantValue
+     */
+    VariantValue member(size_t position) const override;
+
+    /**
+     *  Get access to the key of a member at a certain position, this is the
+     *  name for objects, and the position itself for arrays
+     *  @param  position    Position of the member
+     *  @return VariantValue
+     */
+    VariantValue key(size_t position) const;
+
+    /**
+     *  Create a new iterator over the members
+     *  @return Iterator
+     */
+    SmartTpl::Iterator *iterator() const override;
+};
+
+/**
+ *  End namespace
+ */
+}}
@@ -49,6 +49,20 @@ static struct smart_tpl_callbacks callbacks = {
     .params_append_boolean = smart_tpl_params_append_boolean,
     .mark_failed           = smart_tpl_mark_failed,
     .throw_exception       = smart_tpl_throw_exception,
+    .iterator_fetch        = smart_tpl_iterator_fetch,
+    .vector                = smart_tpl_vector,
+    .vector_size           = smart_tpl_vector_size,
+    .vector_data           = smart_tpl_vector_data,
+    .vector_stride         = smart_tpl_vector_stride,
+    .vector_bind           = smart_tpl_vector_bind,
+    .path                  = smart_tpl_path,
+    .slot_path             = smart_tpl_slot_path,
+    .member_count          = smart_tpl_member_count,
+    .modify_pipeline       = smart_tpl_modify_pipeline,
+    .output_pipeline       = smart_tpl_output_pipeline,
+    .counter               = smart_tpl_counter,
+    .output_double         = smart_tpl_output_double,
+    .pure_modifier         = smart_tpl_pure_modifier,
 };
 
 /**
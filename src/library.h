@@ -19,78 +19,31 @@ class Library : public Executor
 {
 private:
     /**
-     *  Handle to the library
-     *  @var    void*
+     *  The shared library, this object is shared with all other templates
+     *  that were created for the same *.so file
+     *  @var    std::shared_ptr<SharedLibrary>
      */
-    void *_handle = nullptr;
-
-    /**
-     *  Signature of the ShowTemplate function
-     */
-    using ShowTemplate = void(struct smart_tpl_callbacks *callbacks, const void *userdata);
+    std::shared_ptr<SharedLibrary> _library;
 
     /**
      *  The 'show_template' function
      *  @var    function
      */
-    ShowTemplate *_function;
-
-    /**
-     *  Do we depend on personalization data?
-     *  @var    bool
-     */
-    bool _personalized;
-
-    /**
-     *  The 'mode' function
-     */
-    const char *_mode;
+    SharedLibrary::ShowTemplate *_function;
 
 public:
     /**
      *  Constructor
      *  @param  name        Filename of the *.so file
      */
-    Library(const std::string &filename)
-    {
-        // load the library
-        _handle = dlopen(filename.c_str(), RTLD_LAZY | RTLD_LOCAL);
-
-        // must be open
-        if (!_handle) throw std::runtime_error(dlerror());
-
-        // find the show_template symbol
-        _function = (ShowTemplate *) dlsym(_handle, "show_template");
-
-        // function should exist
-        if (!_function) throw std::runtime_error(dlerror());
-
-        // find the personalized symbol
-        int *personalized = static_cast<int*>(dlsym(_handle, "personalized"));
-
-        // it could not exist (when opening older templates), in which
-        // case we assume it to be dependent on personalization data
-        if (!personalized) _personalized = true;
-        else _personalized = *personalized;
-
-        // find the mode symbol
-        const char **mode_ptr = (const char **) dlsym(_handle, "mode");
-
-        // Pointer to mode should exist
-        if (!mode_ptr) throw std::runtime_error(dlerror());
-
-        // Turn the const char ** into const char *
-        _mode = *mode_ptr;
-    }
+    Library(const std::string &filename) :
+        _library(SharedLibrary::open(filename)),
+        _function(_library->function()) {}
 
     /**
      *  Destructor
      */
-    virtual ~Library()
-    {
-        // close the library
-        if (_handle) dlclose(_handle);
-    }
+    virtual ~Library() {}
 
     /**
      *  Execute the template given a certain data source
@@ -105,7 +58,7 @@ public:
      */
     bool personalized() const override
     {
-        return _personalized;
+        return _library->personalized();
     }
 
     /**
@@ -125,7 +78,7 @@ public:
      */
     std::string encoding() override
     {
-        return _mode;
+        return _library->mode();
     }
 };
 
@@ -19,28 +19,35 @@ class MapIterator : public SmartTpl::Iterator
 {
 private:
     /**
-     *  The map we're iterating over
+     *  The members of the map
      */
-    const std::map<std::string, VariantValue> _map;
+    const std::vector<std::pair<std::string, VariantValue>> &_members;
 
     /**
-     *  Iterator to the current position in our map
+     *  Iterator to the current position in the sorted order of the members
      */
-    std::map<std::string, VariantValue>::const_iterator _iter;
+    std::vector<uint32_t>::const_iterator _iter;
 
     /**
      *  End iterator which indicates where we should stop
      */
-    const std::map<std::string, VariantValue>::const_iterator _end;
+    const std::vector<uint32_t>::const_iterator _end;
 
 public:
     /**
      *  Constructor
+     *
+     *  The iterator does not copy the members, but refers to them, so they
+     *  should stay valid for as long as the iterator is in use. The handler
+     *  keeps the iterated values alive during the entire run of a template.
+     *
+     *  @param  members     The members to iterate over
+     *  @param  order       Positions of the members, sorted by key
      */
-    MapIterator(const std::map<std::string, VariantValue> &value)
-    : _map(value),
-      _iter(_map.begin()),
-      _end(_map.end())
+    MapIterator(const std::vector<std::pair<std::string, VariantValue>> &members, const std::vector<uint32_t> &order)
+    : _members(members),
+      _iter(order.begin()),
+      _end(order.end())
     {}
 
     /**
@@ -71,7 +78,7 @@ public:
      */
     VariantValue value() const override
     {
-        return _iter->second;
+        return _members[*_iter].second;
     }
 
     /**
@@ -80,7 +87,30 @@ public:
      */
     VariantValue key() const override
     {
-        return _iter->first;
+        return _members[*_iter].first;
+    }
+
+    /**
+     *  Fetch a number of elements at once, and move past them
+     *  @param  keys        Array for the keys, or nullptr
+     *  @param  values      Array for the values
+     *  @param  max         Size of the arrays
+     *  @return size_t      Number of elements that were fetched
+     */
+    size_t fetch(VariantValue *keys, VariantValue *values, size_t max) override
+    {
+        // number of elements that were fetched
+        size_t count = 0;
+
+        // copy elements until the array is full, or the end is reached
+        for (; count < max && _iter != _end; ++count, ++_iter)
+        {
+            if (keys) keys[count] = _members[*_iter].first;
+            values[count] = _members[*_iter].second;
+        }
+
+        // done
+        return count;
     }
 };
 
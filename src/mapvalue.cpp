@@ -2,7 +2,6 @@
  *  MapValue.cpp
  *
  *  A SmartTpl::Value which represents a map with VariantValues
- *  this is only a cpp file because the map iterator is an internal class
  *
  *  @author Toon Schoenmakers <toon.schoenmakers@copernica.com>
  *  @copyright 2014 Copernica BV
@@ -14,12 +13,170 @@
  */
 namespace SmartTpl {
 
+/**
+ *  Calculate the hash of a key (FNV-1a)
+ *  @param  name        the key
+ *  @param  size        size of the key
+ *  @return size_t
+ */
+size_t MapValue::hash(const char *name, size_t size)
+{
+    // start with the offset basis
+    uint64_t result = 14695981039346656037ULL;
+
+    // mix in all characters
+    for (size_t i = 0; i < size; ++i) result = (result ^ (unsigned char)name[i]) * 1099511628211ULL;
+
+    // done
+    return result;
+}
+
+/**
+ *  Constructor that moves the values out of a std::map
+ *  @param  value
+ */
+MapValue::MapValue(std::map<std::string, VariantValue>&& value) : Value(Type::Map)
+{
+    // make room for all members
+    _value.reserve(value.size());
+
+    // the keys of a map are const, only the values can be moved
+    for (auto &member : value) _value.emplace_back(member.first, std::move(member.second));
+
+    // set up the order and the hash table
+    initialize();
+}
+
+/**
+ *  Find the position of a member
+ *  @param  name        name of the member
+ *  @param  size        size of the name
+ *  @param  hash        hash of the name
+ *  @return size_t      position, or the number of members if it does not exist
+ */
+size_t MapValue::find(const char *name, size_t size, size_t hash) const
+{
+    // an empty map has no hash table
+    if (_index.empty()) return _value.size();
+
+    // the hash table has a power of two size
+    size_t mask = _index.size() - 1;
+
+    // walk through the slots, starting at the slot of the hash
+    for (size_t slot = hash & mask; _index[slot] != 0; slot = (slot + 1) & mask)
+    {
+        // the member in this slot
+        auto position = _index[slot] - 1;
+        auto &key = _value[position].first;
+
+        // is this the one?
+        if (key.size() == size && memcmp(key.data(), name, size) == 0) return position;
+    }
+
+    // not found
+    return _value.size();
+}
+
+/**
+ *  Add a member, or do nothing if there already is a member with this key
+ *  @param  key
+ *  @param  value
+ */
+void MapValue::store(std::string &&key, VariantValue &&value)
+{
+    // the hash of the key
+    auto code = hash(key.data(), key.size());
+
+    // nothing to do if the key is already in use
+    if (find(key.data(), key.size(), code) < _value.size()) return;
+
+    // the position of the new member
+    uint32_t position = _value.size();
+
+    // keys that belong at the end are simply appended to the sorted order
+    if (_order.empty() || _value[_order.back()].first < key) _order.push_back(position);
+    else
+    {
+        // find the place of the key in the sorted order
+        auto iter = std::lower_bound(_order.begin(), _order.end(), key, [this](uint32_t member, const std::string &key) {
+            return _value[member].first < key;
+        });
+
+        // insert the position there
+        _order.insert(iter, position);
+    }
+
+    // append the member
+    _value.emplace_back(std::move(key), std::move(value));
+
+    // the hash table should stay at most half full, it grows by doubling it
+    if (_value.size() * 2 > _index.size()) return rebuild();
+
+    // find the first empty slot
+    size_t mask = _index.size() - 1;
+    size_t slot = code & mask;
+    while (_index[slot] != 0) slot = (slot + 1) & mask;
+
+    // store the position in it
+    _index[slot] = _value.size();
+}
+
+/**
+ *  Set up the sorted order and the hash table, after the members were
+ *  assigned in key order
+ */
+void MapValue::initialize()
+{
+    // the members are in key order
+    _order.resize(_value.size());
+    for (size_t position = 0; position < _value.size(); ++position) _order[position] = position;
+
+    // create the hash table
+    rebuild();
+}
+
+/**
+ *  Rebuild the hash table after the members were changed
+ */
+void MapValue::rebuild()
+{
+    // we need at least twice as many slots as there are members, so that the
+    // sequences of used slots remain short
+    size_t size = _value.empty() ? 0 : 8;
+    while (size < _value.size() * 2) size *= 2;
+
+    // reset the hash table
+    _index.assign(size, 0);
+
+    // the hash table has a power of two size
+    size_t mask = size - 1;
+
+    // add all members
+    for (size_t position = 0; position < _value.size(); ++position)
+    {
+        // the key of the member
+        auto &key = _value[position].first;
+
+        // find the first empty slot
+        size_t slot = hash(key.data(), key.size()) & mask;
+        while (_index[slot] != 0) slot = (slot + 1) & mask;
+
+        // store the position in it
+        _index[slot] = position + 1;
+    }
+}
+
+/**
+ *  Create a new iterator that allows you to iterate over the subvalues
+ *  @return Newly allocated Iterator
+ */
 Iterator *MapValue::iterator() const
 {
-    return new Internal::MapIterator(_value);
+    // the members are iterated in key order
+    return new Internal::MapIterator(_value, _order);
 }
 
 /**
  *  End namespace
  */
-}
\ No newline at end of file
+}
@@ -60,6 +60,20 @@ public:
      */
     const Parameters *parameters() const { return _parameters.get(); };
 
+    /**
+     *  Is this one of the built-in modifiers that always produce the same
+     *  output for the same input? Only these modifiers may be applied in
+     *  advance, for example before a loop instead of in every iteration, and
+     *  only after checking at runtime that the data object did not replace
+     *  them by a modifier of its own
+     *  @return bool
+     */
+    bool pure() const
+    {
+        // the table of built-in modifiers knows which ones have no side effects
+        return Builtins::pure(_name->data(), _name->size());
+    }
+
 };
 
 /**
@@ -51,6 +51,29 @@ public:
      *  @return Type
      */
     virtual Type type() const override { return Type::Boolean; }
+
+    /**
+     *  Collect the names of the variables that the expression depends on
+     *  @param  names       the set to add the names to
+     *  @return bool
+     */
+    virtual bool names(std::set<std::string> &names) const override
+    {
+        // we depend on both sides
+        return _left->names(names) && _right->names(names);
+    }
+
+    /**
+     *  Collect the variables inside the expression that might not change
+     *  during a loop
+     *  @param  invariants
+     */
+    virtual void invariants(Invariants &invariants) const override
+    {
+        // check both sides
+        _left->invariants(invariants);
+        _right->invariants(invariants);
+    }
 };
 
 /**
@@ -30,6 +30,23 @@ public:
      */
     virtual ~BinaryBooleanOperator() {}
 
+    /**
+     *  Collect the variables inside the expression that might not change
+     *  during a loop, the right side is not evaluated if the left side
+     *  already decides the outcome
+     *  @param  invariants
+     */
+    virtual void invariants(Invariants &invariants) const override
+    {
+        // the left side is always evaluated
+        _left->invariants(invariants);
+
+        // the right side might not be
+        invariants.enter();
+        _right->invariants(invariants);
+        invariants.leave();
+    }
+
     /**
      *  Generate the code to get the const char * to the expression
      *  @param  generator
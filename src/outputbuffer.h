@@ -0,0 +1,173 @@
+/**
+ *  OutputBuffer.h
+ *
+ *  The buffer to which the output of a template is written. The layout of
+ *  this class is known to the JIT compiler: the generated code writes raw
+ *  data and numbers directly into the buffer, and only calls back into the
+ *  library when the buffer has to grow.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class OutputBuffer
+{
+public:
+    /**
+     *  Start of the allocated buffer
+     *  @var    char*
+     */
+    char *ptr;
+
+    /**
+     *  Current write position (end of the data that was written so far)
+     *  @var    char*
+     */
+    char *end;
+
+    /**
+     *  End of the allocated buffer
+     *  @var    char*
+     */
+    char *cap;
+
+    /**
+     *  Max number of bytes that is needed to write a numeric value
+     *  @var    size_t
+     */
+    static const size_t numericSize = 20;
+
+    /**
+     *  Constructor
+     *  @param  size        initial capacity
+     */
+    OutputBuffer(size_t size) : ptr((char *)malloc(size)), end(ptr), cap(ptr + size)
+    {
+        // allocation should succeed
+        if (!ptr) throw std::bad_alloc();
+    }
+
+    /**
+     *  Deleted copy constructor
+     *  @param  that
+     */
+    OutputBuffer(const OutputBuffer &that) = delete;
+
+    /**
+     *  Destructor
+     */
+    ~OutputBuffer()
+    {
+        // deallocate the buffer
+        free(ptr);
+    }
+
+    /**
+     *  Make sure that there is room for a number of extra bytes
+     *  @param  size        number of bytes that are going to be written
+     */
+    void reserve(size_t size)
+    {
+        // leap out if there is enough room
+        if ((size_t)(cap - end) >= size) return;
+
+        // the number of bytes in use, and the new capacity (at least double)
+        size_t used = end - ptr;
+        size_t capacity = std::max((size_t)(cap - ptr) * 2, used + size);
+
+        // reallocate the buffer
+        char *buffer = (char *)realloc(ptr, capacity);
+
+        // this should work
+        if (!buffer) throw std::bad_alloc();
+
+        // update the pointers
+        ptr = buffer;
+        end = buffer + used;
+        cap = buffer + capacity;
+    }
+
+    /**
+     *  Append data to the buffer
+     *  @param  data
+     *  @param  size
+     */
+    void append(const char *data, size_t size)
+    {
+        // make sure there is enough room
+        reserve(size);
+
+        // copy the data
+        memcpy(end, data, size);
+
+        // update the write position
+        end += size;
+    }
+
+    /**
+     *  Append a string to the buffer
+     *  @param  data
+     */
+    void append(const std::string &data)
+    {
+        append(data.data(), data.size());
+    }
+
+    /**
+     *  Append the decimal representation of a number to the buffer
+     *  @param  number
+     */
+    void append(numeric_t number)
+    {
+        // make sure there is enough room
+        reserve(numericSize);
+
+        // use an unsigned value so that the lowest number can be negated too
+        unsigned long long value = number;
+
+        // negative numbers start with a minus sign
+        if (number < 0) { *end++ = '-'; value = 0 - value; }
+
+        // count the number of digits
+        size_t digits = 1;
+        for (auto rest = value; rest >= 10; rest /= 10) ++digits;
+
+        // write the digits from right to left
+        char *pos = end + digits;
+        do { *--pos = '0' + value % 10; value /= 10; } while (value);
+
+        // update the write position
+        end += digits;
+    }
+
+    /**
+     *  Size of the data that was written
+     *  @return size_t
+     */
+    size_t size() const
+    {
+        return end - ptr;
+    }
+
+    /**
+     *  Retrieve the written data as a string
+     *  @return std::string
+     */
+    std::string str() const
+    {
+        return std::string(ptr, end);
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
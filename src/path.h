@@ -0,0 +1,130 @@
+/**
+ *  Path.h
+ *
+ *  A precompiled path of members, like $user.address.city, that is resolved
+ *  with a single call at runtime. The names in the path point to the tokens
+ *  of the syntax tree, so the path should not outlive the tree.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class Path
+{
+private:
+    /**
+     *  The steps in the path
+     *  @var    std::vector
+     */
+    std::vector<smart_tpl_path_element> _elements;
+
+    /**
+     *  Does the path start with the name of a variable?
+     *  @var    bool
+     */
+    bool _named = false;
+
+public:
+    /**
+     *  Constructor
+     */
+    Path() {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~Path() {}
+
+    /**
+     *  Start the path with the name of a variable
+     *  @param  name        name of the variable
+     */
+    void variable(const std::string &name)
+    {
+        // the variable is stored as the first element
+        member(name);
+
+        // remember that we start with a variable name
+        _named = true;
+    }
+
+    /**
+     *  Add a member that is accessed by name
+     *  @param  name        name of the member
+     */
+    void member(const std::string &name)
+    {
+        _elements.push_back({ name.data(), name.size(), MapValue::hash(name.data(), name.size()), 0 });
+    }
+
+    /**
+     *  Add a member that is accessed by position
+     *  @param  position    position of the member
+     */
+    void position(size_t position)
+    {
+        _elements.push_back({ nullptr, 0, 0, position });
+    }
+
+    /**
+     *  Does the path start with the name of a variable? If not, it starts
+     *  at a variable that is resolved by other means
+     *  @return bool
+     */
+    bool named() const
+    {
+        return _named;
+    }
+
+    /**
+     *  A textual representation of the path, identical paths have the same key
+     *  @return std::string
+     */
+    std::string key() const
+    {
+        // the result
+        std::string result;
+
+        // add all elements
+        for (auto &element : _elements)
+        {
+            // members by name are separated by dots, positions are between brackets
+            if (element.name) result.append(".").append(element.name, element.size);
+            else result.append("[").append(std::to_string(element.position)).append("]");
+        }
+
+        // done
+        return result;
+    }
+
+    /**
+     *  The steps in the path
+     *  @return const smart_tpl_path_element*
+     */
+    const smart_tpl_path_element *elements() const
+    {
+        return _elements.data();
+    }
+
+    /**
+     *  Number of steps in the path (including the variable name)
+     *  @return size_t
+     */
+    size_t size() const
+    {
+        return _elements.size();
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
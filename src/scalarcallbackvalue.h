@@ -0,0 +1,149 @@
+/**
+ *  ScalarCallbackValue.h
+ *
+ *  Value that is implemented by a callback that returns a plain number,
+ *  boolean or floating point value. The value is tagged with the type of the
+ *  callback, and it stores a plain function that calls the callback, so the
+ *  generated code calls it directly when it needs a scalar of that type,
+ *  without a virtual call and without constructing a VariantValue. All other
+ *  conversions use a temporary object of the built-in value class for the
+ *  type, which lives on the stack.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+template <typename TYPE, typename VALUE, typename RESULT, Value::Type TAG>
+class ScalarCallbackValue : public Value
+{
+private:
+    /**
+     *  The function that is called every time the value is needed
+     *  @var    std::function
+     */
+    std::function<TYPE()> _callback;
+
+    /**
+     *  The function that the generated code calls, with the value itself
+     *  @param  value       Pointer to the value
+     *  @return RESULT
+     */
+    static RESULT call(const void *value)
+    {
+        return static_cast<const ScalarCallbackValue *>(static_cast<const Value *>(value))->_callback();
+    }
+
+public:
+    /**
+     *  Constructor
+     *  @param  callback   The callback function
+     */
+    ScalarCallbackValue(const std::function<TYPE()> &callback) : Value(TAG), _callback(callback)
+    {
+        // store the function for the generated code
+        _function = reinterpret_cast<void (*)()>(&ScalarCallbackValue::call);
+    }
+
+    /**
+     *  Destructor
+     */
+    virtual ~ScalarCallbackValue() {}
+
+    /**
+     *  Convert the value to a string
+     *  @return std::string
+     */
+    std::string toString() const override
+    {
+        return VALUE(_callback()).toString();
+    }
+
+    /**
+     *  Convert the variable to a numeric value
+     *  @return numeric
+     */
+    numeric_t toNumeric() const override
+    {
+        return VALUE(_callback()).toNumeric();
+    }
+
+    /**
+     *  Convert the variable to a boolean value
+     *  @return bool
+     */
+    bool toBoolean() const override
+    {
+        return VALUE(_callback()).toBoolean();
+    }
+
+    /**
+     *  Convert the variable to a floating point value
+     *  @return double
+     */
+    double toDouble() const override
+    {
+        return VALUE(_callback()).toDouble();
+    }
+
+    /**
+     *  Get access to a member value
+     *  @param  name        name of the member
+     *  @param  size        size of the name
+     *  @return VariantValue
+     */
+    VariantValue member(const char *name, size_t size) const override
+    {
+        // scalars have no members
+        return nullptr;
+    }
+
+    /**
+     *  Get access to the amount of members this value has
+     *  @return size_t
+     */
+    size_t memberCount() const override
+    {
+        // scalars have no members
+        return 0;
+    }
+
+    /**
+     *  Get access to a member at a certain position
+     *  @param  position    Position of the item we want to retrieve
+     *  @return VariantValue
+     */
+    VariantValue member(size_t position) const override
+    {
+        // scalars have no members
+        return nullptr;
+    }
+
+    /**
+     *  Scalars can not be iterated over
+     *  @return Iterator
+     */
+    SmartTpl::Iterator *iterator() const override
+    {
+        return nullptr;
+    }
+};
+
+/**
+ *  The callbacks for the different types
+ */
+using NumericCallbackValue = ScalarCallbackValue<numeric_t, NumericValue, numeric_t, Value::Type::NumericCallback>;
+using BooleanCallbackValue = ScalarCallbackValue<bool, BoolValue, int, Value::Type::BooleanCallback>;
+using DoubleCallbackValue = ScalarCallbackValue<double, DoubleValue, double, Value::Type::DoubleCallback>;
+
+/**
+ *  End of namespace
+ */
+}}
@@ -0,0 +1,324 @@
+/**
+ *  SharedLibrary.cpp
+ *
+ *  Implementation of the process wide cache of opened template libraries
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Key under which a library is stored in the cache
+ */
+struct LibraryKey
+{
+    /**
+     *  The canonical path of the library
+     *  @var    std::string
+     */
+    std::string path;
+
+    /**
+     *  Device and inode of the file
+     *  @var    dev_t, ino_t
+     */
+    dev_t device;
+    ino_t inode;
+
+    /**
+     *  Last modification time of the file
+     *  @var    struct timespec
+     */
+    struct timespec mtime;
+
+    /**
+     *  Compare operator, necessary for storing the key in a map
+     *  @param  that
+     *  @return bool
+     */
+    bool operator<(const LibraryKey &that) const
+    {
+        // compare the cheap numeric members first
+        if (inode != that.inode) return inode < that.inode;
+        if (device != that.device) return device < that.device;
+        if (mtime.tv_sec != that.mtime.tv_sec) return mtime.tv_sec < that.mtime.tv_sec;
+        if (mtime.tv_nsec != that.mtime.tv_nsec) return mtime.tv_nsec < that.mtime.tv_nsec;
+
+        // and finally the path
+        return path < that.path;
+    }
+};
+
+/**
+ *  Helper function to construct the key for a certain file
+ *  @param  filename
+ *  @return LibraryKey
+ *  @throws std::runtime_error
+ */
+static LibraryKey key(const std::string &filename)
+{
+    // find the canonical path
+    char *path = realpath(filename.c_str(), nullptr);
+
+    // file should exist
+    if (!path) throw std::runtime_error(filename + ": " + strerror(errno));
+
+    // the key that we're going to construct
+    LibraryKey result;
+
+    // store the path, and free the buffer that was allocated by realpath()
+    result.path = path;
+    free(path);
+
+    // find the file properties
+    struct stat info;
+    if (stat(result.path.c_str(), &info) != 0) throw std::runtime_error(filename + ": " + strerror(errno));
+
+    // store them in the key
+    result.device = info.st_dev;
+    result.inode = info.st_ino;
+    result.mtime = info.st_mtim;
+
+    // done
+    return result;
+}
+
+/**
+ *  Private copy of a library
+ *
+ *  The dynamic loader returns the library that is already loaded when it is
+ *  asked to open a file with the same name, even if the file was replaced or
+ *  overwritten in the meantime. That is why a new version of a library that
+ *  was opened before is loaded from a copy. The copy is created with
+ *  mkstemps(), so it gets a name that nobody else can claim and it is only
+ *  accessible by us. The copy is removed as soon as it is opened, the loaded
+ *  library stays in memory.
+ */
+class LibraryCopy
+{
+private:
+    /**
+     *  Path of the copy
+     *  @var    std::string
+     */
+    std::string _path;
+
+public:
+    /**
+     *  Constructor
+     *  @param  id          Key of the library to copy
+     *  @throws std::runtime_error
+     */
+    LibraryCopy(const LibraryKey &id)
+    {
+        // the directory for temporary files
+        const char *directory = getenv("TMPDIR");
+
+        // the template for the name of the copy
+        std::string name = std::string(directory && *directory ? directory : "/tmp") + "/smarttpl-XXXXXX.so";
+
+        // create the file, the name is filled in by mkstemps()
+        std::vector<char> buffer(name.begin(), name.end());
+        buffer.push_back('\0');
+        int output = mkstemps(buffer.data(), 3);
+        if (output < 0) throw std::runtime_error(name + ": " + strerror(errno));
+        _path = buffer.data();
+
+        // open the original
+        int input = ::open(id.path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        // copy the file
+        bool success = input >= 0 && copy(input, output);
+
+        // close the files
+        if (input >= 0) close(input);
+        if (close(output) != 0) success = false;
+
+        // check if this worked
+        if (success) return;
+
+        // remove the copy, the destructor is not called when we throw
+        unlink(_path.c_str());
+
+        // report the error
+        throw std::runtime_error(id.path + ": could not copy library to " + _path);
+    }
+
+    /**
+     *  Destructor, removes the copy
+     */
+    virtual ~LibraryCopy()
+    {
+        unlink(_path.c_str());
+    }
+
+    /**
+     *  Path of the copy
+     *  @return const char *
+     */
+    const char *path() const
+    {
+        return _path.c_str();
+    }
+
+private:
+    /**
+     *  Helper method to copy the contents of a file
+     *  @param  input       File descriptor to read from
+     *  @param  output      File descriptor to write to
+     *  @return bool
+     */
+    static bool copy(int input, int output)
+    {
+        // buffer for the data
+        char buffer[65536];
+
+        // read until the end of the file
+        while (true)
+        {
+            // read the next block
+            auto size = read(input, buffer, sizeof(buffer));
+            if (size == 0) return true;
+            if (size < 0 && errno == EINTR) continue;
+            if (size < 0) return false;
+
+            // write it all
+            for (ssize_t written = 0; written < size; )
+            {
+                auto result = write(output, buffer + written, size - written);
+                if (result < 0 && errno == EINTR) continue;
+                if (result < 0) return false;
+                written += result;
+            }
+        }
+    }
+};
+
+/**
+ *  Mutex to protect the cache
+ *  @var    std::mutex
+ */
+static std::mutex mutex;
+
+/**
+ *  The libraries that are loaded, the most recent version of every file is
+ *  kept in memory, so creating a template for it is only a table lookup. The
+ *  previous version is removed from the cache when a file is replaced, it is
+ *  closed when the last template that uses it is destructed
+ *  @var    std::map
+ */
+static std::map<LibraryKey, std::shared_ptr<SharedLibrary>> libraries;
+
+/**
+ *  The preloaded libraries, these are kept in memory even if they are replaced
+ *  @var    std::map
+ */
+static std::map<LibraryKey, std::shared_ptr<SharedLibrary>> preloaded;
+
+/**
+ *  The files that were opened under their own name, opening them under that
+ *  name again would return the version that was loaded first
+ *  @var    std::set
+ */
+static std::set<std::string> opened;
+
+/**
+ *  Helper function to load a version of a library and store it in the cache,
+ *  the mutex should be locked
+ *  @param  id          Key of the library
+ *  @param  flags       Flags to pass to dlopen()
+ *  @return std::shared_ptr
+ *  @throws std::runtime_error
+ */
+static std::shared_ptr<SharedLibrary> load(const LibraryKey &id, int flags)
+{
+    // the library that we are going to load
+    std::shared_ptr<SharedLibrary> result;
+
+    // the first version of a file is opened under its own name, later versions from a copy
+    if (opened.find(id.path) == opened.end())
+    {
+        // open the original file
+        result = std::make_shared<SharedLibrary>(id.path.c_str(), flags);
+
+        // remember that the loader now knows this name
+        opened.insert(id.path);
+    }
+    else
+    {
+        // open a private copy of this version
+        LibraryCopy copy(id);
+        result = std::make_shared<SharedLibrary>(copy.path(), flags);
+    }
+
+    // forget about the other versions of the same file
+    for (auto i = libraries.begin(); i != libraries.end(); )
+    {
+        // remove the entry if it is an older (or newer) version
+        if (i->first.path == id.path) i = libraries.erase(i);
+        else ++i;
+    }
+
+    // store it in the cache
+    libraries[id] = result;
+
+    // done
+    return result;
+}
+
+/**
+ *  Open a library, or get access to the instance that is already in
+ *  memory for the same file.
+ *  @param  filename    Filename of the *.so file
+ *  @return std::shared_ptr
+ *  @throws std::runtime_error
+ */
+std::shared_ptr<SharedLibrary> SharedLibrary::open(const std::string &filename)
+{
+    // find the key of the file (this does not need the lock)
+    auto id = key(filename);
+
+    // the cache is shared by all threads
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // look for the library in the cache
+    auto iter = libraries.find(id);
+    if (iter != libraries.end()) return iter->second;
+
+    // load it with lazy binding, just like dlopen() did before the cache existed
+    return load(id, RTLD_LAZY | RTLD_LOCAL);
+}
+
+/**
+ *  Load a library with all its symbols bound immediately, and keep it in
+ *  memory for the rest of the lifetime of the process.
+ *  @param  filename    Filename of the *.so file
+ *  @throws std::runtime_error
+ */
+void SharedLibrary::preload(const std::string &filename)
+{
+    // find the key of the file
+    auto id = key(filename);
+
+    // the cache is shared by all threads
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // nothing to do if it was already preloaded
+    if (preloaded.find(id) != preloaded.end()) return;
+
+    // the version that is already in memory is kept alive, otherwise we load
+    // it with all symbols bound immediately
+    auto iter = libraries.find(id);
+    preloaded[id] = iter != libraries.end() ? iter->second : load(id, RTLD_NOW | RTLD_LOCAL);
+}
+
+/**
+ *  End namespace
+ */
+}}
@@ -0,0 +1,202 @@
+/**
+ *  SharedLibrary.h
+ *
+ *  Wrapper around a dlopen()'ed template library and the symbols that were
+ *  resolved from it. Instances are shared between all Library executors that
+ *  were created for the same *.so file: a process wide cache keeps track of
+ *  the libraries that are loaded, so that creating a template from a library
+ *  that is already in memory is nothing more than a table lookup.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class SharedLibrary
+{
+public:
+    /**
+     *  Signature of the ShowTemplate function
+     */
+    using ShowTemplate = void(struct smart_tpl_callbacks *callbacks, const void *userdata);
+
+private:
+    /**
+     *  Handle to the library
+     *  @var    void*
+     */
+    void *_handle = nullptr;
+
+    /**
+     *  The file that the library was loaded from, it stays open while the
+     *  library is loaded, so that its inode can not be reused by a new file
+     *  (the loader would mistake such a file for this library)
+     *  @var    int
+     */
+    int _file = -1;
+
+    /**
+     *  The 'show_template' function
+     *  @var    function
+     */
+    ShowTemplate *_function = nullptr;
+
+    /**
+     *  Do we depend on personalization data?
+     *  @var    bool
+     */
+    bool _personalized = true;
+
+    /**
+     *  The 'mode' of the template
+     *  @var    const char *
+     */
+    const char *_mode = nullptr;
+
+public:
+    /**
+     *  Constructor
+     *
+     *  You normally do not call this directly, but use the static open()
+     *  method instead, so that the library is shared with other templates
+     *
+     *  @param  filename    Filename of the *.so file
+     *  @param  flags       Flags to pass to dlopen()
+     *  @throws std::runtime_error
+     */
+    SharedLibrary(const char *filename, int flags)
+    {
+        // keep the file open
+        _file = ::open(filename, O_RDONLY | O_CLOEXEC);
+
+        // load the library
+        _handle = dlopen(filename, flags);
+
+        // must be open
+        if (!_handle) fail();
+
+        // find the show_template symbol
+        _function = (ShowTemplate *) dlsym(_handle, "show_template");
+
+        // function should exist
+        if (!_function) fail();
+
+        // find the personalized symbol
+        int *personalized = static_cast<int*>(dlsym(_handle, "personalized"));
+
+        // it could not exist (when opening older templates), in which
+        // case we assume it to be dependent on personalization data
+        if (personalized) _personalized = *personalized;
+
+        // find the mode symbol
+        const char **mode_ptr = (const char **) dlsym(_handle, "mode");
+
+        // Pointer to mode should exist
+        if (!mode_ptr) fail();
+
+        // Turn the const char ** into const char *
+        _mode = *mode_ptr;
+    }
+
+    /**
+     *  Deleted copy constructor
+     *  @param  that
+     */
+    SharedLibrary(const SharedLibrary &that) = delete;
+
+    /**
+     *  Destructor
+     */
+    virtual ~SharedLibrary()
+    {
+        // close the library
+        if (_handle) dlclose(_handle);
+
+        // and the file
+        if (_file >= 0) close(_file);
+    }
+
+    /**
+     *  Open a library, or get access to the instance that is already in
+     *  memory for the same file. Libraries are identified by their canonical
+     *  path, device, inode and modification time. The first version of a file
+     *  is opened under its own name, a *.so file that was replaced or
+     *  overwritten on disk is loaded again from a private copy, even if the
+     *  previous version is still in use (or preloaded)
+     *
+     *  @param  filename    Filename of the *.so file
+     *  @return std::shared_ptr
+     *  @throws std::runtime_error
+     */
+    static std::shared_ptr<SharedLibrary> open(const std::string &filename);
+
+    /**
+     *  Load a library with all its symbols bound immediately (RTLD_NOW), and
+     *  keep it in memory for the rest of the lifetime of the process. Templates
+     *  that are later created for the same file do not suffer from the costs
+     *  of lazy binding during their first run.
+     *
+     *  @param  filename    Filename of the *.so file
+     *  @throws std::runtime_error
+     */
+    static void preload(const std::string &filename);
+
+    /**
+     *  The show_template function
+     *  @return ShowTemplate
+     */
+    ShowTemplate *function() const
+    {
+        return _function;
+    }
+
+    /**
+     *  Does the template use personalisation data?
+     *  @return bool
+     */
+    bool personalized() const
+    {
+        return _personalized;
+    }
+
+    /**
+     *  The encoding that the template uses natively
+     *  @return const char *
+     */
+    const char *mode() const
+    {
+        return _mode;
+    }
+
+private:
+    /**
+     *  Helper method to throw an exception after a failed dlsym() call, the
+     *  destructor is not called when we throw from the constructor, so we
+     *  have to close the library ourselves
+     *  @throws std::runtime_error
+     */
+    void fail()
+    {
+        // construct the error before the handle is closed
+        std::runtime_error error(dlerror());
+
+        // close the library and the file
+        if (_handle) dlclose(_handle);
+        if (_file >= 0) close(_file);
+
+        // and report the error
+        throw error;
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
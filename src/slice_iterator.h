@@ -0,0 +1,114 @@
+/**
+ *  Slice_Iterator.h
+ *
+ *  Iterator over a part of the elements of another iterator. The elements
+ *  before the slice are skipped when the iterator is constructed, and the
+ *  iterator stops after the last element of the slice without touching the
+ *  rest of the elements.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class SliceIterator : public SmartTpl::Iterator
+{
+private:
+    /**
+     *  The iterator over all elements
+     *  @var    std::unique_ptr
+     */
+    std::unique_ptr<SmartTpl::Iterator> _iterator;
+
+    /**
+     *  Number of elements that are left in the slice
+     *  @var    size_t
+     */
+    size_t _remaining;
+
+public:
+    /**
+     *  Constructor
+     *  @param  iterator    The iterator over all elements (we take ownership)
+     *  @param  offset      Number of elements to skip
+     *  @param  length      Max number of elements
+     */
+    SliceIterator(SmartTpl::Iterator *iterator, size_t offset, size_t length) :
+        _iterator(iterator), _remaining(length)
+    {
+        // skip the elements before the slice
+        for (; offset > 0 && _iterator->valid(); --offset) _iterator->next();
+    }
+
+    /**
+     *  Destructor
+     */
+    virtual ~SliceIterator() {}
+
+    /**
+     *  Check if the iterator is still valid
+     *  @return bool
+     */
+    bool valid() const override
+    {
+        return _remaining > 0 && _iterator->valid();
+    }
+
+    /**
+     *  Move to the next position
+     */
+    void next() override
+    {
+        --_remaining;
+        _iterator->next();
+    }
+
+    /**
+     *  Retrieve pointer to the current member
+     *  @return Variant
+     */
+    VariantValue value() const override
+    {
+        return _iterator->value();
+    }
+
+    /**
+     *  Retrieve a pointer to the current key
+     *  @return Variant
+     */
+    VariantValue key() const override
+    {
+        return _iterator->key();
+    }
+
+    /**
+     *  Fetch a number of elements at once, and move past them
+     *  @param  keys        Array for the keys, or nullptr
+     *  @param  values      Array for the values
+     *  @param  max         Size of the arrays
+     *  @return size_t      Number of elements that were fetched
+     */
+    size_t fetch(VariantValue *keys, VariantValue *values, size_t max) override
+    {
+        // the underlying iterator fetches the elements, but not past the end of the slice
+        size_t count = _remaining > 0 ? _iterator->fetch(keys, values, std::min(max, _remaining)) : 0;
+
+        // update the number of remaining elements
+        _remaining -= count;
+
+        // done
+        return count;
+    }
+};
+
+/**
+ *  End namespace
+ */
+}}
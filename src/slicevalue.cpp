@@ -0,0 +1,134 @@
+/**
+ *  SliceValue.cpp
+ *
+ *  A view on a consecutive part of the members of another value, this is
+ *  only a cpp file because the iterators are internal classes
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Constructor
+ *  @param  source      The original value
+ *  @param  offset      Position of the first member
+ *  @param  length      Max number of members
+ */
+SliceValue::SliceValue(const Value &source, size_t offset, size_t length) :
+    _offset(offset), _length(length)
+{
+    // variants are cheap to copy, and this keeps them alive
+    if (typeid(source) == typeid(VariantValue)) { _source = static_cast<const VariantValue &>(source); return; }
+
+    // callbacks are asked for their value, which is kept alive too
+    if (typeid(source) == typeid(CallbackValue)) { _source = static_cast<const CallbackValue &>(source).value(); return; }
+
+    // other values are not owned by anyone we know of, so the members of the slice are copied
+    std::vector<VariantValue> values;
+    auto *iterator = source.iterator();
+    if (iterator) for (SliceIterator slice(iterator, offset, length); slice.valid(); slice.next())
+    {
+        // copy the key and the value
+        _keys.push_back(slice.key());
+        values.push_back(slice.value());
+    }
+
+    // the copy holds exactly the members of the slice
+    _offset = 0;
+    _length = _count = values.size();
+    _counted = true;
+    _source = std::move(values);
+}
+
+/**
+ *  The vector that holds the members of the original value, if it is a
+ *  plain vector
+ *  @return const std::vector<VariantValue>*
+ */
+const std::vector<VariantValue> *SliceValue::elements() const
+{
+    // look through the variants
+    const Value *value = &_source;
+    while (value && typeid(*value) == typeid(VariantValue)) value = static_cast<const VariantValue *>(value)->wrapped();
+
+    // only plain vectors expose their elements
+    if (!value || typeid(*value) != typeid(VectorValue)) return nullptr;
+
+    // expose the elements
+    return &static_cast<const VectorValue *>(value)->elements();
+}
+
+/**
+ *  Get access to a member value
+ *  @param  name        name of the member
+ *  @param  size        size of the name
+ *  @return VariantValue
+ */
+VariantValue SliceValue::member(const char *name, size_t size) const
+{
+    // the member that we're looking for
+    std::string key(name, size);
+
+    // look through the members of the slice
+    std::unique_ptr<SmartTpl::Iterator> iter(iterator());
+    for (; iter && iter->valid(); iter->next()) if (iter->key().toString() == key) return iter->value();
+
+    // not found
+    return nullptr;
+}
+
+/**
+ *  Get access to the amount of members this value has
+ *  @return size_t
+ */
+size_t SliceValue::memberCount() const
+{
+    // the members are counted only once
+    if (_counted) return _count;
+    _counted = true;
+
+    // the number of members of the original value
+    size_t count = _source.memberCount();
+
+    // if that is known, the slice contains the members after the offset
+    if (count > 0) return _count = count > _offset ? std::min(count - _offset, _length) : 0;
+
+    // values that can only be iterated over do not know their size, so we count
+    std::unique_ptr<SmartTpl::Iterator> iter(iterator());
+    for (; iter && iter->valid(); iter->next()) ++_count;
+
+    // done
+    return _count;
+}
+
+/**
+ *  Create a new iterator over the members of the slice
+ *  @return Iterator
+ */
+SmartTpl::Iterator *SliceValue::iterator() const
+{
+    // copied members are iterated over with their original keys
+    if (!_keys.empty()) return new VectorIterator(*elements(), _keys);
+
+    // plain vectors are iterated over from the offset onwards
+    auto *vector = elements();
+    if (vector) return new VectorIterator(*vector, _offset, _length);
+
+    // other values are iterated over with their own iterator
+    auto *iterator = _source.iterator();
+    if (!iterator) return nullptr;
+
+    // skip the members before the slice
+    return new SliceIterator(iterator, _offset, _length);
+}
+
+/**
+ *  End namespace
+ */
+}}
@@ -0,0 +1,156 @@
+/**
+ *  SliceValue.h
+ *
+ *  A view on a consecutive part of the members of another value. Nothing is
+ *  copied when the view is created: the members are taken from the original
+ *  value when they are accessed, so they keep their order and their keys.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class SliceValue : public Value
+{
+private:
+    /**
+     *  The original value, or a copy of the members of the slice if the
+     *  original value could be gone before the slice is used
+     *  @var    VariantValue
+     */
+    VariantValue _source;
+
+    /**
+     *  The keys of the members, if the members were copied
+     *  @var    std::vector
+     */
+    std::vector<VariantValue> _keys;
+
+    /**
+     *  Position of the first member
+     *  @var    size_t
+     */
+    size_t _offset;
+
+    /**
+     *  Max number of members
+     *  @var    size_t
+     */
+    size_t _length;
+
+    /**
+     *  The number of members, once it is known
+     *  @var    size_t
+     */
+    mutable size_t _count = 0;
+
+    /**
+     *  Were the members counted?
+     *  @var    bool
+     */
+    mutable bool _counted = false;
+
+    /**
+     *  The vector that holds the members of the original value, if it is a
+     *  plain vector
+     *  @return const std::vector<VariantValue>*
+     */
+    const std::vector<VariantValue> *elements() const;
+
+public:
+    /**
+     *  Constructor
+     *  @param  source      The original value
+     *  @param  offset      Position of the first member
+     *  @param  length      Max number of members
+     */
+    SliceValue(const Value &source, size_t offset, size_t length);
+
+    /**
+     *  Destructor
+     */
+    virtual ~SliceValue() {}
+
+    /**
+     *  Convert the value to a string
+     *  @return std::string
+     */
+    std::string toString() const override
+    {
+        return "";
+    }
+
+    /**
+     *  Convert the variable to a numeric value
+     *  @return numeric
+     */
+    numeric_t toNumeric() const override
+    {
+        return 0;
+    }
+
+    /**
+     *  Convert the variable to a boolean value
+     *  @return bool
+     */
+    bool toBoolean() const override
+    {
+        return memberCount() > 0;
+    }
+
+    /**
+     *  Convert the variable to a floating point value
+     *  @return double
+     */
+    double toDouble() const override
+    {
+        return 0.0;
+    }
+
+    /**
+     *  Get access to a member value, this has to look through the keys of
+     *  the slice, because the key might belong to a member outside of it
+     *  @param  name        name of the member
+     *  @param  size        size of the name
+     *  @return VariantValue
+     */
+    VariantValue member(const char *name, size_t size) const override;
+
+    /**
+     *  Get access to the amount of members this value has
+     *  @return size_t
+     */
+    size_t memberCount() const override;
+
+    /**
+     *  Get access to a member at a certain position
+     *  @param  position    Position of the item we want to retrieve
+     *  @return VariantValue
+     */
+    VariantValue member(size_t position) const override
+    {
+        // positions outside the slice do not exist
+        if (position >= _length) return nullptr;
+
+        // ask the original value
+        return _source.member(_offset + position);
+    }
+
+    /**
+     *  Create a new iterator over the members of the slice
+     *  @return Iterator
+     */
+    SmartTpl::Iterator *iterator() const override;
+};
+
+/**
+ *  End namespace
+ */
+}}
@@ -52,6 +52,20 @@ public:
     {
         generator->assign(*_var, _expression.get());
     }
+
+    /**
+     *  Collect the names that are assigned inside the statement, and the
+     *  variables that might not change during a loop
+     *  @param  invariants
+     */
+    void invariants(Invariants &invariants) const override
+    {
+        // the variable gets a new value
+        invariants.bind(*_var);
+
+        // the expression could contain variables that do not change
+        _expression->invariants(invariants);
+    }
 };
 
 /**
@@ -44,6 +44,15 @@ public:
     {
         _expression->output(generator);
     }
+
+    /**
+     *  Collect the variables that might not change during a loop
+     *  @param  invariants
+     */
+    void invariants(Invariants &invariants) const override
+    {
+        _expression->invariants(invariants);
+    }
 };
 
 /**
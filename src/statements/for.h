@@ -0,0 +1,126 @@
+/**
+ *  For.h
+ *
+ *  Implementation of the for statement, {for $i = 1 to 10 step 2}, which
+ *  counts from one number to another. The counter is a native number in
+ *  the generated code, so no values are created while looping. Because of
+ *  this, the counter can not be assigned inside the loop. Like the variables
+ *  of a foreach loop, the counter keeps its last value after the loop.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class ForStatement : public Statement
+{
+private:
+    /**
+     *  The variable name that will contain the counter during the loop
+     *  @var Token
+     */
+    std::unique_ptr<Token> _name;
+
+    /**
+     *  The first value of the counter
+     *  @var Expression
+     */
+    std::unique_ptr<Expression> _from;
+
+    /**
+     *  The last value of the counter
+     *  @var Expression
+     */
+    std::unique_ptr<Expression> _to;
+
+    /**
+     *  The value that is added to the counter after every iteration
+     *  @note This is not a requirement, the default step is 1
+     *  @var Expression
+     */
+    std::unique_ptr<Expression> _step;
+
+    /**
+     *  The statements to execute within the loop
+     *  @var Statements
+     */
+    std::unique_ptr<Statements> _statements;
+
+public:
+    /**
+     *  Constructor
+     *  @param  name            Name of the counter variable
+     *  @param  from            The first value of the counter
+     *  @param  to              The last value of the counter
+     *  @param  statements      The statements to execute in the loop
+     */
+    ForStatement(Token *name, Expression *from, Expression *to, Statements *statements) :
+        _name(name), _from(from), _to(to), _statements(statements) {}
+
+    /**
+     *  Constructor
+     *  @param  name            Name of the counter variable
+     *  @param  from            The first value of the counter
+     *  @param  to              The last value of the counter
+     *  @param  step            The value to add after every iteration
+     *  @param  statements      The statements to execute in the loop
+     */
+    ForStatement(Token *name, Expression *from, Expression *to, Expression *step, Statements *statements) :
+        _name(name), _from(from), _to(to), _step(step), _statements(statements) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~ForStatement() {}
+
+    /**
+     *  Generate the output of this statement
+     *  @param  generator
+     *  @throws CompileError    If the counter is assigned inside the loop
+     */
+    void generate(Generator *generator) const override
+    {
+        // find the names that are assigned inside the loop
+        Invariants invariants("", "");
+        _statements->invariants(invariants);
+
+        // the counter is a native number, so it can not get another value
+        if (invariants.bound(*_name)) throw CompileError("Counter $" + *_name + " is assigned inside its for loop");
+
+        // generate the loop
+        generator->count(*_name, _from.get(), _to.get(), _step.get(), _statements.get());
+    }
+
+    /**
+     *  Collect the names that are assigned inside the statement, and the
+     *  variables that might not change during a loop
+     *  @param  invariants
+     */
+    void invariants(Invariants &invariants) const override
+    {
+        // the counter gets a new value every iteration
+        invariants.bind(*_name);
+
+        // the boundaries are always evaluated
+        _from->invariants(invariants);
+        _to->invariants(invariants);
+        if (_step) _step->invariants(invariants);
+
+        // the statements inside the loop might not be executed
+        invariants.enter();
+        _statements->invariants(invariants);
+        invariants.leave();
+    }
+};
+
+/**
+ *  End of namespace
+ */
+}}
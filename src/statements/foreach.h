@@ -88,6 +88,27 @@ public:
         // otherwise we call the generator with a reference to the key
         else generator->foreach(_source.get(), *_key, *_value, _statements.get(), _else_statements.get());
     }
+
+    /**
+     *  Collect the names that are assigned inside the statement, and the
+     *  variables that might not change during a loop
+     *  @param  invariants
+     */
+    void invariants(Invariants &invariants) const override
+    {
+        // the key and value of this loop get new values too
+        if (_key) invariants.bind(*_key);
+        invariants.bind(*_value);
+
+        // the source is always evaluated
+        _source->invariants(invariants);
+
+        // the statements inside the loop might not be executed
+        invariants.enter();
+        _statements->invariants(invariants);
+        if (_else_statements) _else_statements->invariants(invariants);
+        invariants.leave();
+    }
 };
 
 /**
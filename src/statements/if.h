@@ -68,6 +68,23 @@ public:
         // generate a condition statement
         generator->condition(_expression.get(), _trueStatements.get(), _falseStatements.get());
     }
+
+    /**
+     *  Collect the names that are assigned inside the statement, and the
+     *  variables that might not change during a loop
+     *  @param  invariants
+     */
+    void invariants(Invariants &invariants) const override
+    {
+        // the condition is always evaluated
+        _expression->invariants(invariants);
+
+        // only one of the branches is executed
+        invariants.enter();
+        _trueStatements->invariants(invariants);
+        if (_falseStatements) _falseStatements->invariants(invariants);
+        invariants.leave();
+    }
 };
 
 /**
@@ -43,6 +43,13 @@ public:
      */
     virtual void generate(Generator *generator) const = 0;
 
+    /**
+     *  Collect the names that are assigned inside the statement, and the
+     *  variables that might not change during a loop
+     *  @param  invariants
+     */
+    virtual void invariants(Invariants &invariants) const {}
+
 };
 
 /**
@@ -59,6 +59,17 @@ public:
         // loop through the statements, and output each one of them
         for (auto &statement : _statements) statement->generate(generator);
     }
+
+    /**
+     *  Collect the names that are assigned inside the statements, and the
+     *  variables that might not change during a loop
+     *  @param  invariants
+     */
+    void invariants(Invariants &invariants) const override
+    {
+        // process all statements
+        for (auto &statement : _statements) statement->invariants(invariants);
+    }
 };
 
 /**
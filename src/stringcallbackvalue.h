@@ -0,0 +1,136 @@
+/**
+ *  StringCallbackValue.h
+ *
+ *  Value that is implemented by a callback that writes a string into a
+ *  buffer. When the value is printed, the callback writes into a scratch
+ *  buffer that the handler reuses for every call, so no VariantValue and no
+ *  new string have to be constructed for it.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace SmartTpl { namespace Internal {
+
+/**
+ *  Class definition
+ */
+class StringCallbackValue : public Value
+{
+private:
+    /**
+     *  The function that is called every time the value is needed
+     *  @var    StringCallback
+     */
+    StringCallback _callback;
+
+public:
+    /**
+     *  Constructor
+     *  @param  callback   The callback function
+     */
+    StringCallbackValue(const StringCallback &callback) : _callback(callback) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~StringCallbackValue() {}
+
+    /**
+     *  Let the callback append the string to a buffer
+     *  @param  buffer      The buffer to write to
+     */
+    void write(std::string &buffer) const
+    {
+        _callback(buffer);
+    }
+
+    /**
+     *  Convert the value to a string
+     *  @return std::string
+     */
+    std::string toString() const override
+    {
+        // let the callback fill the string
+        std::string result;
+        _callback(result);
+        return result;
+    }
+
+    /**
+     *  Convert the variable to a numeric value
+     *  @return numeric
+     */
+    numeric_t toNumeric() const override
+    {
+        return StringValue(toString()).toNumeric();
+    }
+
+    /**
+     *  Convert the variable to a boolean value
+     *  @return bool
+     */
+    bool toBoolean() const override
+    {
+        return StringValue(toString()).toBoolean();
+    }
+
+    /**
+     *  Convert the variable to a floating point value
+     *  @return double
+     */
+    double toDouble() const override
+    {
+        return StringValue(toString()).toDouble();
+    }
+
+    /**
+     *  Get access to a member value
+     *  @param  name        name of the member
+     *  @param  size        size of the name
+     *  @return VariantValue
+     */
+    VariantValue member(const char *name, size_t size) const override
+    {
+        // strings have no members
+        return nullptr;
+    }
+
+    /**
+     *  Get access to the amount of members this value has
+     *  @return size_t
+     */
+    size_t memberCount() const override
+    {
+        // strings have no members
+        return 0;
+    }
+
+    /**
+     *  Get access to a member at a certain position
+     *  @param  position    Position of the item we want to retrieve
+     *  @return VariantValue
+     */
+    VariantValue member(size_t position) const override
+    {
+        // strings have no members
+        return nullptr;
+    }
+
+    /**
+     *  Strings can not be iterated over
+     *  @return Iterator
+     */
+    SmartTpl::Iterator *iterator() const override
+    {
+        return nullptr;
+    }
+};
+
+/**
+ *  End of namespace
+ */
+}}
@@ -22,7 +22,8 @@ Template::Template(const Source &source)
     // is the source a shared library?
     if (source.library())
     {
-        // hey that's cool, we can create create a shard library
+        // hey that's cool, we can create create a shard library (libraries that are
+        // already loaded by other templates are shared)
         _executor = new Internal::Library(source.name());
     }
     else
@@ -44,6 +45,16 @@ Template::~Template()
     delete _executor;
 }
 
+/**
+ *  Preload a compiled template (*.so file)
+ *  @param  filename      Path to the shared library
+ */
+void Template::preload(const std::string &filename)
+{
+    // pass on to the library cache
+    Internal::SharedLibrary::preload(filename);
+}
+
 /**
  *  Is this template dependent on data to be personalised?
  *
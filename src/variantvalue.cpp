@@ -14,42 +14,184 @@
 namespace SmartTpl {
 
 /**
- *  Constructors, one for most scalar types
- */
-VariantValue::VariantValue() : _value(new NullValue()) {}
-VariantValue::VariantValue(std::nullptr_t value) : _value(new NullValue()) {}
-VariantValue::VariantValue(bool value) : _value(new BoolValue(value)) {}
-VariantValue::VariantValue(int16_t value) : _value(new NumericValue(value)) {}
-VariantValue::VariantValue(int32_t value) : _value(new NumericValue(value)) {}
-VariantValue::VariantValue(int64_t value) : _value(new NumericValue(value)) {}
-VariantValue::VariantValue(double value) : _value(new DoubleValue(value)) {}
-VariantValue::VariantValue(const char* value) : _value(value ? (Value *)new StringValue(value) : (Value *)new NullValue()) {}
-VariantValue::VariantValue(const char* value, size_t len) : _value(value ? (Value *)new StringValue(value, len) : (Value *)new NullValue()) {}
-VariantValue::VariantValue(std::string value) : _value(new StringValue(std::move(value))) {}
-VariantValue::VariantValue(const std::vector<VariantValue>& value) : _value(new VectorValue(value)) {};
-VariantValue::VariantValue(std::vector<VariantValue>&& value) : _value(new VectorValue(std::move(value))) {};
-VariantValue::VariantValue(const std::initializer_list<VariantValue>& value) : _value(new VectorValue(value)) {};
-VariantValue::VariantValue(const std::map<std::string, VariantValue>& value) : _value(new MapValue(value)) {};
-VariantValue::VariantValue(std::map<std::string, VariantValue>&& value) : _value(new MapValue(std::move(value))) {};
-VariantValue::VariantValue(const std::initializer_list<std::map<std::string, VariantValue>::value_type>& value) : _value(new MapValue(value)) {};
-
-/**
- *  Assignment operators, one for most scalar types just like the constructors
- */
-VariantValue& VariantValue::operator=(std::nullptr_t value) { _value.reset(new NullValue()); return *this; }
-VariantValue& VariantValue::operator=(bool value) { _value.reset(new BoolValue(value)); return *this; }
-VariantValue& VariantValue::operator=(int16_t value) { _value.reset(new NumericValue(value)); return *this; }
-VariantValue& VariantValue::operator=(int32_t value) { _value.reset(new NumericValue(value)); return *this; }
-VariantValue& VariantValue::operator=(int64_t value) { _value.reset(new NumericValue(value)); return *this; }
-VariantValue& VariantValue::operator=(double value) { _value.reset(new DoubleValue(value)); return *this; }
-VariantValue& VariantValue::operator=(const char* value) { _value.reset(value ? (Value *)new StringValue(value) : (Value *)new NullValue()); return *this; }
-VariantValue& VariantValue::operator=(std::string value) { _value.reset(new StringValue(std::move(value))); return *this; }
-VariantValue& VariantValue::operator=(const std::vector<VariantValue>& value) { _value.reset(new VectorValue(value)); return *this; }
-VariantValue& VariantValue::operator=(std::vector<VariantValue>&& value) { _value.reset(new VectorValue(std::move(value))); return *this; }
-VariantValue& VariantValue::operator=(const std::initializer_list<VariantValue>& value) { _value.reset(new VectorValue(value)); return *this; }
-VariantValue& VariantValue::operator=(const std::map<std::string, VariantValue>& value) { _value.reset(new MapValue(value)); return *this; }
-VariantValue& VariantValue::operator=(std::map<std::string, VariantValue>&& value) { _value.reset(new MapValue(std::move(value))); return *this; }
-VariantValue& VariantValue::operator=(const std::initializer_list<std::map<std::string, VariantValue>::value_type>& value) { _value.reset(new MapValue(value)); return *this; }
+ *  Constructors for strings and containers, the scalar constructors are
+ *  implemented in the header file
+ */
+VariantValue::VariantValue(const char* value) : Value(Type::Null) { if (value) assign(value, strlen(value)); }
+VariantValue::VariantValue(const char* value, size_t len) : Value(Type::Null) { if (value) assign(value, len); }
+VariantValue::VariantValue(std::string value) : Value(Type::Null) { assign(std::move(value)); }
+VariantValue::VariantValue(const std::vector<VariantValue>& value) : Value(Type::Vector), _value(new VectorValue(value)) {};
+VariantValue::VariantValue(std::vector<VariantValue>&& value) : Value(Type::Vector), _value(new VectorValue(std::move(value))) {};
+VariantValue::VariantValue(const std::initializer_list<VariantValue>& value) : Value(Type::Vector), _value(new VectorValue(value)) {};
+VariantValue::VariantValue(const std::map<std::string, VariantValue>& value) : Value(Type::Map), _value(new MapValue(value)) {};
+VariantValue::VariantValue(std::map<std::string, VariantValue>&& value) : Value(Type::Map), _value(new MapValue(std::move(value))) {};
+VariantValue::VariantValue(const std::initializer_list<std::map<std::string, VariantValue>::value_type>& value) : Value(Type::Map), _value(new MapValue(value)) {};
+
+/**
+ *  Assignment operators for strings and containers
+ */
+VariantValue& VariantValue::operator=(const char* value) { clear(); if (value) assign(value, strlen(value)); return *this; }
+VariantValue& VariantValue::operator=(std::string value) { clear(); assign(std::move(value)); return *this; }
+VariantValue& VariantValue::operator=(const std::vector<VariantValue>& value) { _value.reset(new VectorValue(value)); tag(); return *this; }
+VariantValue& VariantValue::operator=(std::vector<VariantValue>&& value) { _value.reset(new VectorValue(std::move(value))); tag(); return *this; }
+VariantValue& VariantValue::operator=(const std::initializer_list<VariantValue>& value) { _value.reset(new VectorValue(value)); tag(); return *this; }
+VariantValue& VariantValue::operator=(const std::map<std::string, VariantValue>& value) { _value.reset(new MapValue(value)); tag(); return *this; }
+VariantValue& VariantValue::operator=(std::map<std::string, VariantValue>&& value) { _value.reset(new MapValue(std::move(value))); tag(); return *this; }
+VariantValue& VariantValue::operator=(const std::initializer_list<std::map<std::string, VariantValue>::value_type>& value) { _value.reset(new MapValue(value)); tag(); return *this; }
+
+/**
+ *  Store a string, short strings are stored inline
+ *  @param  value
+ *  @param  size
+ */
+void VariantValue::assign(const char *value, size_t size)
+{
+    // long strings have to be allocated
+    if (size > sizeof(_buffer)) _value = std::make_shared<StringValue>(value, size);
+
+    // short strings are copied into the buffer
+    else memcpy(_buffer, value, size);
+
+    // store the type and length
+    _type = Type::String;
+    _numeric = size;
+}
+
+/**
+ *  Store a string, short strings are stored inline
+ *  @param  value
+ */
+void VariantValue::assign(std::string &&value)
+{
+    // short strings are copied into the buffer
+    if (value.size() <= sizeof(_buffer)) return assign(value.data(), value.size());
+
+    // long strings are moved into a string value
+    _value = std::make_shared<StringValue>(std::move(value));
+
+    // store the type and length
+    _type = Type::String;
+    _numeric = 0;
+}
+
+/**
+ *  Convert the value to a string
+ *  @return std::string
+ */
+std::string VariantValue::toString() const
+{
+    // return the toString of the underlying Value
+    if (_value) return _value->toString();
+
+    // inline values are converted just like the value classes do
+    switch (_type) {
+    case Type::Bool:    return BoolValue(_numeric != 0).toString();
+    case Type::Numeric: return NumericValue(_numeric).toString();
+    case Type::Double:  return DoubleValue(_double).toString();
+    case Type::String:  return std::string(_buffer, _numeric);
+    default:            return NullValue().toString();
+    }
+}
+
+/**
+ *  Convert the variable to a numeric value
+ *  @return numeric
+ */
+numeric_t VariantValue::toNumeric() const
+{
+    // return the toNumeric of the underlying Value
+    if (_value) return _value->toNumeric();
+
+    // inline values are converted just like the value classes do
+    switch (_type) {
+    case Type::Double:  return DoubleValue(_double).toNumeric();
+    case Type::String:  return StringValue(_buffer, _numeric).toNumeric();
+    default:            return _numeric;
+    }
+}
+
+/**
+ *  Convert the variable to a boolean value
+ *  @return bool
+ */
+bool VariantValue::toBoolean() const
+{
+    // return the toBoolean of the underlying Value
+    if (_value) return _value->toBoolean();
+
+    // inline values are converted just like the value classes do
+    switch (_type) {
+    case Type::Double:  return DoubleValue(_double).toBoolean();
+    case Type::String:  return StringValue(_buffer, _numeric).toBoolean();
+    default:            return _numeric != 0;
+    }
+}
+
+/**
+ *  Convert the variable to a floating point value
+ *  @return double
+ */
+double VariantValue::toDouble() const
+{
+    // return the toDouble of the underlying Value
+    if (_value) return _value->toDouble();
+
+    // inline values are converted just like the value classes do
+    switch (_type) {
+    case Type::Double:  return _double;
+    case Type::String:  return StringValue(_buffer, _numeric).toDouble();
+    default:            return _numeric;
+    }
+}
+
+/**
+ *  Compare two variants
+ *  @param  that
+ *  @return bool
+ */
+bool VariantValue::operator==(const VariantValue &that) const
+{
+    // wrapped values are equal if they wrap the same object
+    if (_value || that._value) return _value == that._value;
+
+    // inline values should be of the same type
+    if (_type != that._type) return false;
+
+    // compare the inline data
+    switch (_type) {
+    case Type::Double:  return _double == that._double;
+    case Type::String:  return _numeric == that._numeric && memcmp(_buffer, that._buffer, _numeric) == 0;
+    default:            return _numeric == that._numeric;
+    }
+}
+
+/**
+ *  Copy the type tag and the scalar of the wrapped value into this object, so
+ *  that the generated code does not have to look inside the wrapped value
+ */
+void VariantValue::tag()
+{
+    // an empty pointer is just a null value
+    if (!_value) return clear();
+
+    // copy the type
+    _type = _value->type();
+
+    // and the scalar (if there is one)
+    switch (_type) {
+    case Type::Null:
+    case Type::Bool:
+    case Type::Numeric: _numeric = _value->toNumeric(); break;
+    case Type::Double:  _double = _value->toDouble(); break;
+
+    // the function of a typed callback expects the callback value itself, and
+    // not this wrapper, so the generated code should ask us for the scalar
+    case Type::NumericCallback:
+    case Type::BooleanCallback:
+    case Type::DoubleCallback:  _type = Type::Custom; break;
+    default:            break;
+    }
+}
 
 /**
  *  End namespace
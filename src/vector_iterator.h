@@ -18,11 +18,6 @@ namespace SmartTpl { namespace Internal {
 class VectorIterator : public SmartTpl::Iterator
 {
 private:
-    /**
-     *  The vector we're iterating over
-     */
-    const std::vector<VariantValue> _vector;
-
     /**
      *  Iterator to the current position in our vector
      */
@@ -38,17 +33,52 @@ private:
      */
     numeric_t _count;
 
+    /**
+     *  The keys of the elements, if they are not their positions
+     */
+    const std::vector<VariantValue> *_keys = nullptr;
+
 public:
     /**
      *  Constructor
+     *
+     *  The iterator does not copy the vector, but refers to it, so the vector
+     *  should stay valid for as long as the iterator is in use. The handler
+     *  keeps the iterated values alive during the entire run of a template.
+     *
+     *  @param  value       The vector to iterate over
      */
     VectorIterator(const std::vector<VariantValue> &value)
-    : _vector(value),
-      _iter(_vector.begin()),
-      _end(_vector.end()),
+    : _iter(value.begin()),
+      _end(value.end()),
       _count(0)
     {}
 
+    /**
+     *  Constructor for a part of the vector, the keys are the positions in
+     *  the entire vector
+     *  @param  value       The vector to iterate over
+     *  @param  offset      Position of the first element
+     *  @param  length      Max number of elements
+     */
+    VectorIterator(const std::vector<VariantValue> &value, size_t offset, size_t length)
+    : _iter(value.begin() + std::min(offset, value.size())),
+      _end(value.begin() + std::min(offset + std::min(length, value.size()), value.size())),
+      _count(offset)
+    {}
+
+    /**
+     *  Constructor for elements with keys of their own
+     *  @param  value       The vector to iterate over
+     *  @param  keys        The keys of the elements (same size as the vector)
+     */
+    VectorIterator(const std::vector<VariantValue> &value, const std::vector<VariantValue> &keys)
+    : _iter(value.begin()),
+      _end(value.end()),
+      _count(0),
+      _keys(&keys)
+    {}
+
     /**
      *  Deconstructor
      */
@@ -87,7 +117,30 @@ public:
      */
     VariantValue key() const override
     {
-        return _count;
+        return _keys ? (*_keys)[_count] : VariantValue(_count);
+    }
+
+    /**
+     *  Fetch a number of elements at once, and move past them
+     *  @param  keys        Array for the keys, or nullptr
+     *  @param  values      Array for the values
+     *  @param  max         Size of the arrays
+     *  @return size_t      Number of elements that were fetched
+     */
+    size_t fetch(VariantValue *keys, VariantValue *values, size_t max) override
+    {
+        // number of elements that were fetched
+        size_t count = 0;
+
+        // copy elements until the array is full, or the end is reached
+        for (; count < max && _iter != _end; ++count, ++_iter, ++_count)
+        {
+            if (keys) keys[count] = _keys ? (*_keys)[_count] : VariantValue(_count);
+            values[count] = *_iter;
+        }
+
+        // done
+        return count;
     }
 };
 
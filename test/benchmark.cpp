@@ -0,0 +1,218 @@
+/**
+ *  Benchmark.cpp
+ *
+ *  Micro benchmarks, these tests check the output of a template just like the
+ *  other tests, and report how long it takes to process it a number of times
+ *  with both jit and the compiled shared library
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2014 - 2017 Copernica BV
+ */
+
+#include <gtest/gtest.h>
+#include <../smarttpl.h>
+#include <chrono>
+
+#include "ccode.h"
+
+using namespace SmartTpl;
+using namespace std;
+
+/**
+ *  Process a template a number of times, and report the time it took
+ *  @param  name        Name to report
+ *  @param  tpl         The template to process
+ *  @param  data        The data to process it with
+ *  @param  runs        Number of runs
+ */
+static void measure(const char *name, const Template &tpl, const Data &data, size_t runs = 10000)
+{
+    // start the clock
+    auto start = chrono::steady_clock::now();
+
+    // process the template over and over again
+    for (size_t i = 0; i < runs; ++i) tpl.process(data);
+
+    // the time it took
+    auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+    // report it
+    cout << "[ BENCHMARK] " << name << ": " << runs << " runs in " << elapsed.count() << "us" << endl;
+}
+
+/**
+ *  Arithmetic and comparisons on scalar variables, with the type tags of the
+ *  values the scalars are read inline instead of through virtual calls
+ */
+TEST(Benchmark, ArithmeticComparison)
+{
+    string input;
+    string expectedOutput;
+    for (int i = 0; i < 50; ++i)
+    {
+        input.append("{if $a * 2 + $b > $c}{$a + $b * $c - 1}{/if}{if $d >= 1.5}d{/if}{if $e}e{/if}");
+        expectedOutput.append("16de");
+    }
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("a", 3)
+        .assign("b", 2)
+        .assign("c", 7)
+        .assign("d", 2.5)
+        .assign("e", true);
+
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    measure("ArithmeticComparison (jit)", tpl, data);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+        measure("ArithmeticComparison (shared library)", library, data);
+    }
+}
+
+/**
+ *  Looking up members of a big map by name, and by position
+ */
+TEST(Benchmark, MapAccess)
+{
+    string input("{foreach $keys as $key}{$map[$key]}{/foreach}{$map[999]}");
+    Template tpl((Buffer(input)));
+
+    vector<VariantValue> keys;
+    std::map<std::string, VariantValue> map;
+    string expectedOutput;
+    for (int i = 0; i < 1000; ++i)
+    {
+        // the keys are sorted in the map, so k999 is the last one
+        string key("k" + to_string(i));
+        keys.push_back(key);
+        map[key] = i % 10;
+        expectedOutput.append(to_string(i % 10));
+    }
+    expectedOutput.append("9");
+
+    Data data;
+    data.assign("keys", std::move(keys))
+        .assign("map", std::move(map));
+
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    measure("MapAccess (jit)", tpl, data, 1000);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+        measure("MapAccess (shared library)", library, data, 1000);
+    }
+}
+
+/**
+ *  A vector class of our own, the library does not know how its elements
+ *  are stored, so it is iterated over with an iterator
+ */
+class IteratedVector : public VectorValue
+{
+public:
+    using VectorValue::VectorValue;
+};
+
+/**
+ *  Iterating over vectors, plain vectors are iterated over with an index
+ *  while other vectors use their iterator
+ */
+TEST(Benchmark, ForEachVector)
+{
+    string input("{foreach $vector as $i => $element}{$element}{/foreach}");
+    Template tpl((Buffer(input)));
+
+    // a small and a big vector, the first one is processed more often
+    for (auto size : { 1000, 1000000 })
+    {
+        size_t runs = size == 1000 ? 10000 : 10;
+
+        vector<VariantValue> elements;
+        string expectedOutput;
+        for (int i = 0; i < size; ++i)
+        {
+            elements.push_back(i % 10);
+            expectedOutput.append(to_string(i % 10));
+        }
+
+        Data plain;
+        plain.assign("vector", elements);
+
+        Data iterated;
+        iterated.assignManaged("vector", new IteratedVector(std::move(elements)));
+
+        string name("ForEachVector " + to_string(size));
+        EXPECT_EQ(expectedOutput, tpl.process(plain));
+        EXPECT_EQ(expectedOutput, tpl.process(iterated));
+        measure((name + " indexed (jit)").c_str(), tpl, plain, runs);
+        measure((name + " iterator (jit)").c_str(), tpl, iterated, runs);
+
+        if (compile(tpl)) // This will compile the Template into a shared library
+        {
+            Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+            EXPECT_EQ(expectedOutput, library.process(plain));
+            EXPECT_EQ(expectedOutput, library.process(iterated));
+            measure((name + " indexed (shared library)").c_str(), library, plain, runs);
+            measure((name + " iterator (shared library)").c_str(), library, iterated, runs);
+        }
+    }
+}
+
+/**
+ *  Taking the first items of a big list, the range modifier does not copy
+ *  the list, so this does not depend on the size of the list
+ */
+TEST(Benchmark, RangeOfBigList)
+{
+    string input("{foreach $list|range:10 as $item}{$item}{/foreach}");
+    Template tpl((Buffer(input)));
+
+    vector<VariantValue> list;
+    for (int i = 0; i < 1000000; ++i) list.push_back(i % 10);
+
+    Data data;
+    data.assign("list", std::move(list));
+
+    string expectedOutput("0123456789");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    measure("RangeOfBigList (jit)", tpl, data);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+        measure("RangeOfBigList (shared library)", library, data);
+    }
+}
+
+/**
+ *  About 1000 chained string modifiers, these all modify the same buffer in
+ *  place, so no values are created for the intermediate results
+ */
+TEST(Benchmark, ChainedModifiers)
+{
+    string input("{$var");
+    for (int i = 0; i < 500; ++i) input.append("|upper|lower");
+    input.push_back('}');
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("var", "VaRiAbLe");
+
+    string expectedOutput("variable");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    measure("ChainedModifiers (jit)", tpl, data, 1000);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+        measure("ChainedModifiers (shared library)", library, data, 1000);
+    }
+}
@@ -102,4 +102,142 @@ TEST(Callbacks, Counter)
         EXPECT_EQ(expectedOutput, library.process(data));
         EXPECT_EQ(5, counter);
     }
-}
\ No newline at end of file
+}
+
+TEST(Callbacks, CallbackCachingPerProcess)
+{
+    string input("{if $i}{$i}{/if} {$i}");
+    Template tpl((Buffer(input)));
+
+    int counter = 0;
+    Data data;
+    data.callback("i", [&counter]() {
+        return ++counter;
+    }, Caching::Process);
+
+    // every process call calls the callback exactly once
+    EXPECT_EQ("1 1", tpl.process(data));
+    EXPECT_EQ("2 2", tpl.process(data));
+    EXPECT_EQ(2, counter);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        counter = 0; // Reset our counter
+
+        EXPECT_EQ("1 1", library.process(data));
+        EXPECT_EQ("2 2", library.process(data));
+        EXPECT_EQ(2, counter);
+    }
+}
+
+TEST(Callbacks, StructuredCallback)
+{
+    string input("{foreach $order in $orders}{$order.id}:{$order.total} {/foreach}{$orders.1.id} {$orders|count}");
+    Template tpl((Buffer(input)));
+
+    int counter = 0;
+    Data data;
+    data.callback("orders", [&counter]() {
+        counter++;
+        std::vector<VariantValue> orders;
+        orders.push_back(std::map<std::string, VariantValue>({{ "id", 1 }, { "total", "9.95" }}));
+        orders.push_back(std::map<std::string, VariantValue>({{ "id", 2 }, { "total", "20.00" }}));
+        return orders;
+    })
+    .callback("unused", [&counter]() {
+        counter += 100;
+        return std::vector<VariantValue>();
+    });
+
+    // the members are taken from a single call per process call, the
+    // modifier gets the callback itself and calls it once more
+    string expectedOutput("1:9.95 2:20.00 2 2");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    EXPECT_EQ(2, counter);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        counter = 0; // Reset our counter
+
+        EXPECT_EQ(expectedOutput, library.process(data));
+        EXPECT_EQ(2, counter);
+    }
+}
+
+TEST(Callbacks, TypedCallbacks)
+{
+    string input("{if $admin}{$count + 1} {$name} {$name|toupper}{/if}{if $count == 41} ok{/if}{if $price > 1} expensive{/if}");
+    Template tpl((Buffer(input)));
+
+    int counter = 0;
+    Data data;
+    data.callbackNumeric("count", [&counter]() -> numeric_t {
+        counter++;
+        return 41;
+    })
+    .callbackBoolean("admin", []() { return true; })
+    .callbackDouble("price", []() { return 1.25; })
+    .callbackString("name", [](std::string &buffer) { buffer.append("john"); });
+
+    string expectedOutput("42 john JOHN ok expensive");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    EXPECT_EQ(2, counter);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+class ProfileValue : public Value
+{
+private:
+    int *_counter;
+
+public:
+    ProfileValue(int *counter) : Value(Type::Map), _counter(counter) {}
+    std::string toString() const override { return ""; }
+    numeric_t toNumeric() const override { return 0; }
+    bool toBoolean() const override { return true; }
+    double toDouble() const override { return 0.0; }
+    VariantValue member(const char *name, size_t size) const override
+    {
+        (*_counter)++;
+        return std::map<std::string, VariantValue>({{ "name", "John" }});
+    }
+    size_t memberCount() const override { return 1; }
+    VariantValue member(size_t position) const override { return nullptr; }
+    Iterator *iterator() const override { return nullptr; }
+};
+
+TEST(Callbacks, PathMemoization)
+{
+    string input("{$customer.profile.name} {$customer.profile.name} {assign $other to $customer}{$customer.profile.name}|"
+                 "{foreach $rows as $row}{$row.id}{$row.id}{/foreach}");
+    Template tpl((Buffer(input)));
+
+    int counter = 0;
+    ProfileValue customer(&counter);
+
+    Data data;
+    data.assignValue("customer", &customer)
+        .assign("other", std::map<std::string, VariantValue>({{ "profile", std::map<std::string, VariantValue>({{ "name", "Jane" }}) }}))
+        .assign("rows", std::vector<VariantValue>({ std::map<std::string, VariantValue>({{ "id", 1 }}), std::map<std::string, VariantValue>({{ "id", 2 }}) }));
+
+    // identical paths are resolved once per run, until the variable where they start is assigned
+    string expectedOutput("John John Jane|1122");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    EXPECT_EQ(1, counter);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        counter = 0; // Reset our counter
+
+        EXPECT_EQ(expectedOutput, library.process(data));
+        EXPECT_EQ(1, counter);
+    }
+}
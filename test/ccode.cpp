@@ -22,11 +22,27 @@ TEST(CCode, ForEach)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n{\n"
-    "void *iterator = callbacks->create_iterator(userdata,callbacks->variable(userdata,\"map\",3));\n"
-    "while (callbacks->valid_iterator(userdata,iterator)) {\n"
-    "callbacks->assign(userdata,\"key\",3,callbacks->iterator_value(userdata,iterator));\n"
-    "callbacks->write(userdata,\"key: \",5);\ncallbacks->output(userdata,callbacks->variable(userdata,\"key\",3),1);\n"
-    "callbacks->write(userdata,\"\\n\",1);\ncallbacks->iterator_next(userdata,iterator);\n}\n}\n}\n"
+    "const void *source = callbacks->variable(userdata,\"map\",3);\n"
+    "const void *vector = callbacks->vector(userdata,source);\n"
+    "void *iterator = vector ? 0 : callbacks->create_iterator(userdata,source);\n"
+    "size_t size = vector ? callbacks->vector_size(userdata,vector) : 0;\n"
+    "int known = vector ? 1 : 0;\n"
+    "size_t index = 0;\n"
+    "(void)known;\n"
+    "const char *data = vector ? (const char *)callbacks->vector_data(userdata,vector) : 0;\n"
+    "const size_t stride = vector ? callbacks->vector_stride(userdata) : 0;\n"
+    "const void *element = 0;\n"
+    "(void)element;\n"
+    "if ((vector ? (index < size ? (element = data + index * stride,++index) : 0) : (callbacks->iterator_fetch(userdata,iterator,0,0,\"key\",3) ? ++index : 0))) {\n"
+    "do {\n"
+    "callbacks->write(userdata,\"key: \",5);\n"
+    "callbacks->output(userdata,(vector ? element : callbacks->variable(userdata,\"key\",3)),1);\n"
+    "callbacks->write(userdata,\"\\n\",1);\n"
+    "} while ((vector ? (index < size ? (element = data + index * stride,++index) : 0) : (callbacks->iterator_fetch(userdata,iterator,0,0,\"key\",3) ? ++index : 0)));\n"
+    "if (vector) callbacks->vector_bind(userdata,vector,index - 1,0,0,\"key\",3);\n"
+    "}\n"
+    "}\n"
+    "}\n"
     "int personalized = 1;\n"
     "const char *mode = \"raw\";\n");
     EXPECT_EQ(expectedOutput, tpl.compile());
@@ -41,14 +57,28 @@ TEST(CCode, ForEachWithKeys)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n{\n"
-    "void *iterator = callbacks->create_iterator(userdata,callbacks->variable(userdata,\"map\",3));\n"
-    "while (callbacks->valid_iterator(userdata,iterator)) {\n"
-    "callbacks->assign(userdata,\"key\",3,callbacks->iterator_key(userdata,iterator));\n"
-    "callbacks->assign(userdata,\"value\",5,callbacks->iterator_value(userdata,iterator));\n"
-    "callbacks->write(userdata,\"key: \",5);\ncallbacks->output(userdata,callbacks->variable(userdata,\"key\",3),1);\n"
+    "const void *source = callbacks->variable(userdata,\"map\",3);\n"
+    "const void *vector = callbacks->vector(userdata,source);\n"
+    "void *iterator = vector ? 0 : callbacks->create_iterator(userdata,source);\n"
+    "size_t size = vector ? callbacks->vector_size(userdata,vector) : 0;\n"
+    "int known = vector ? 1 : 0;\n"
+    "size_t index = 0;\n"
+    "(void)known;\n"
+    "const char *data = vector ? (const char *)callbacks->vector_data(userdata,vector) : 0;\n"
+    "const size_t stride = vector ? callbacks->vector_stride(userdata) : 0;\n"
+    "const void *element = 0;\n"
+    "(void)element;\n"
+    "if ((vector ? (index < size ? (element = data + index * stride,++index) : 0) : (callbacks->iterator_fetch(userdata,iterator,\"key\",3,\"value\",5) ? ++index : 0))) {\n"
+    "do {\n"
+    "callbacks->write(userdata,\"key: \",5);\n"
+    "callbacks->output(userdata,(vector ? callbacks->counter(userdata,\"key\",3,(numeric_t)index - 1) : callbacks->variable(userdata,\"key\",3)),1);\n"
     "callbacks->write(userdata,\"\\nvalue: \",8);\n"
-    "callbacks->output(userdata,callbacks->variable(userdata,\"value\",5),1);\n"
-    "callbacks->iterator_next(userdata,iterator);\n}\n}\n}\n"
+    "callbacks->output(userdata,(vector ? element : callbacks->variable(userdata,\"value\",5)),1);\n"
+    "} while ((vector ? (index < size ? (element = data + index * stride,++index) : 0) : (callbacks->iterator_fetch(userdata,iterator,\"key\",3,\"value\",5) ? ++index : 0)));\n"
+    "if (vector) callbacks->vector_bind(userdata,vector,index - 1,\"key\",3,\"value\",5);\n"
+    "}\n"
+    "}\n"
+    "}\n"
     "int personalized = 1;\n"
     "const char *mode = \"raw\";\n");
     EXPECT_EQ(expectedOutput, tpl.compile());
@@ -63,12 +93,29 @@ TEST(CCode, ForEachElse)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n{\n"
-    "void *iterator = callbacks->create_iterator(userdata,callbacks->variable(userdata,\"map\",3));\n"
-    "if (!callbacks->valid_iterator(userdata,iterator)) {\ncallbacks->write(userdata,\"else\",4);\n} else {\n"
-    "while (callbacks->valid_iterator(userdata,iterator)) {\n"
-    "callbacks->assign(userdata,\"key\",3,callbacks->iterator_value(userdata,iterator));\n"
-    "callbacks->write(userdata,\"key: \",5);\ncallbacks->output(userdata,callbacks->variable(userdata,\"key\",3),1);\n"
-    "callbacks->write(userdata,\"\\n\",1);\ncallbacks->iterator_next(userdata,iterator);\n}\n}\n}\n}\n"
+    "const void *source = callbacks->variable(userdata,\"map\",3);\n"
+    "const void *vector = callbacks->vector(userdata,source);\n"
+    "void *iterator = vector ? 0 : callbacks->create_iterator(userdata,source);\n"
+    "size_t size = vector ? callbacks->vector_size(userdata,vector) : 0;\n"
+    "int known = vector ? 1 : 0;\n"
+    "size_t index = 0;\n"
+    "(void)known;\n"
+    "const char *data = vector ? (const char *)callbacks->vector_data(userdata,vector) : 0;\n"
+    "const size_t stride = vector ? callbacks->vector_stride(userdata) : 0;\n"
+    "const void *element = 0;\n"
+    "(void)element;\n"
+    "if ((vector ? (index < size ? (element = data + index * stride,++index) : 0) : (callbacks->iterator_fetch(userdata,iterator,0,0,\"key\",3) ? ++index : 0))) {\n"
+    "do {\n"
+    "callbacks->write(userdata,\"key: \",5);\n"
+    "callbacks->output(userdata,(vector ? element : callbacks->variable(userdata,\"key\",3)),1);\n"
+    "callbacks->write(userdata,\"\\n\",1);\n"
+    "} while ((vector ? (index < size ? (element = data + index * stride,++index) : 0) : (callbacks->iterator_fetch(userdata,iterator,0,0,\"key\",3) ? ++index : 0)));\n"
+    "if (vector) callbacks->vector_bind(userdata,vector,index - 1,0,0,\"key\",3);\n"
+    "} else {\n"
+    "callbacks->write(userdata,\"else\",4);\n"
+    "}\n"
+    "}\n"
+    "}\n"
     "int personalized = 1;\n"
     "const char *mode = \"raw\";\n");
     EXPECT_EQ(expectedOutput, tpl.compile());
@@ -83,9 +130,9 @@ TEST(CCode, SingleModifier)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n"
-    "callbacks->output(userdata,callbacks->modify_variable(userdata,"
+    "callbacks->output_pipeline(userdata,"
     "callbacks->variable(userdata,\"var\",3),"
-    "callbacks->modifier(userdata,\"toupper\",7),NULL),1);\n}\n"
+    "callbacks->modifier(userdata,\"toupper\",7),NULL,1);\n}\n"
     "int personalized = 1;\n"
     "const char *mode = \"raw\";\n");
     EXPECT_EQ(expectedOutput, tpl.compile());
@@ -100,12 +147,12 @@ TEST(CCode, ChainedModifiers)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n"
-    "callbacks->output(userdata,callbacks->modify_variable(userdata,"
-    "callbacks->modify_variable(userdata,callbacks->modify_variable(userdata,"
-    "callbacks->modify_variable(userdata,callbacks->variable(userdata,\"var\",3),"
+    "callbacks->output_pipeline(userdata,"
+    "callbacks->modify_pipeline(userdata,callbacks->modify_pipeline(userdata,"
+    "callbacks->modify_pipeline(userdata,callbacks->variable(userdata,\"var\",3),"
     "callbacks->modifier(userdata,\"toupper\",7),NULL),callbacks->modifier(userdata,"
     "\"tolower\",7),NULL),callbacks->modifier(userdata,\"toupper\",7),NULL),"
-    "callbacks->modifier(userdata,\"tolower\",7),NULL),1);\n}\nint personalized = 1;\nconst char *mode = \"raw\";\n");
+    "callbacks->modifier(userdata,\"tolower\",7),NULL,1);\n}\nint personalized = 1;\nconst char *mode = \"raw\";\n");
     EXPECT_EQ(expectedOutput, tpl.compile());
 
     compile(tpl);
@@ -118,7 +165,7 @@ TEST(CCode, IfElse)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n"
-    "if (callbacks->to_boolean(userdata,callbacks->variable(userdata,\"variable\",8))){\n"
+    "if (smart_tpl_boolean(callbacks,userdata,callbacks->variable(userdata,\"variable\",8))){\n"
     "callbacks->write(userdata,\"true\",4);\n}else{\ncallbacks->write(userdata,\"false\",5);\n}\n}\n"
     "int personalized = 1;\n"
     "const char *mode = \"raw\";\n");
@@ -134,9 +181,9 @@ TEST(CCode, ElseIf)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n"
-    "if (callbacks->to_boolean(userdata,callbacks->variable(userdata,\"variable\",8))){\n"
+    "if (smart_tpl_boolean(callbacks,userdata,callbacks->variable(userdata,\"variable\",8))){\n"
     "callbacks->write(userdata,\"first is true\",13);\n}else{\n"
-    "if (callbacks->to_boolean(userdata,callbacks->variable(userdata,\"othervariable\",13))){\n"
+    "if (smart_tpl_boolean(callbacks,userdata,callbacks->variable(userdata,\"othervariable\",13))){\n"
     "callbacks->write(userdata,\"second is true\",14);\n}else{\n"
     "callbacks->write(userdata,\"nothing is true\",15);\n}\n}\n}\n"
     "int personalized = 1;\n"
@@ -167,7 +214,7 @@ TEST(CCode, IfNotVar)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n"
-    "if (!callbacks->to_boolean(userdata,callbacks->variable(userdata,\"var\",3))){\n"
+    "if (!smart_tpl_boolean(callbacks,userdata,callbacks->variable(userdata,\"var\",3))){\n"
     "callbacks->write(userdata,\"true\",4);\n}else{\ncallbacks->write(userdata,\"false\",5);\n}\n}\n"
     "int personalized = 1;\nconst char *mode = \"raw\";\n");
     EXPECT_EQ(expectedOutput, tpl.compile());
@@ -182,7 +229,7 @@ TEST(CCode, VarGreaterThen)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n"
-    "if (callbacks->to_double(userdata,callbacks->variable(userdata,\"age\",3))>18){\n"
+    "if (smart_tpl_double(callbacks,userdata,callbacks->variable(userdata,\"age\",3))>18){\n"
     "callbacks->write(userdata,\"You are over 18 years old.\",26);\n}\n}\n"
     "int personalized = 1;\n"
     "const char *mode = \"raw\";\n");
@@ -198,7 +245,7 @@ TEST(CCode, VarGreaterThenNegativeNumber)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n"
-    "if (callbacks->to_double(userdata,callbacks->variable(userdata,\"age\",3))>-1){\n"
+    "if (smart_tpl_double(callbacks,userdata,callbacks->variable(userdata,\"age\",3))>-1){\n"
     "callbacks->write(userdata,\"You are alive..\",15);\n}\n}\n"
     "int personalized = 1;\n"
     "const char *mode = \"raw\";\n");
@@ -214,9 +261,9 @@ TEST(CCode, LiteralArrayAccess)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n"
-    "callbacks->output(userdata,callbacks->member_at(userdata,callbacks->variable(userdata,\"map\",3),0),1);\n"
+    "callbacks->output(userdata,callbacks->slot_path(userdata,0,(const struct smart_tpl_path_element[]){{\"map\",3,580780841256168849ULL,0},{0,0,0,0}},2),1);\n"
     "callbacks->write(userdata,\"\\n\",1);\n"
-    "callbacks->output(userdata,callbacks->member(userdata,callbacks->variable(userdata,\"map\",3),\"anothermember\",13),1);\n}\n"
+    "callbacks->output(userdata,callbacks->slot_path(userdata,1,(const struct smart_tpl_path_element[]){{\"map\",3,580780841256168849ULL,0},{\"anothermember\",13,16948612413031075974ULL,0}},2),1);\n}\n"
     "int personalized = 1;\n"
     "const char *mode = \"raw\";\n");
     EXPECT_EQ(expectedOutput, tpl.compile());
@@ -356,11 +403,11 @@ TEST(CCode, ModifierParameters)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n"
-    "callbacks->output(userdata,callbacks->modify_variable(userdata,"
+    "callbacks->output_pipeline(userdata,"
     "callbacks->variable(userdata,\"var\",3),callbacks->modifier(userdata,\"substring\",9),"
     "callbacks->params_append_numeric(userdata,"
     "callbacks->params_append_numeric(userdata,"
-    "callbacks->create_params(userdata,2),1),5)),1);\n}\n"
+    "callbacks->create_params(userdata,2),1),5),1);\n}\n"
     "int personalized = 1;\n"
     "const char *mode = \"raw\";\n");
     EXPECT_EQ(expectedOutput, tpl.compile());
@@ -457,8 +504,8 @@ TEST(CCode, OutputMath)
 
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n"
-    "callbacks->write(userdata,\"1+3-2*10=\",9);\ncallbacks->output_numeric(userdata,((1+3)-(2*10)));\n"
-    "callbacks->write(userdata,\"\\n(1+3-2)*10=\",12);\ncallbacks->output_numeric(userdata,(((1+3)-2)*10));\n}\n"
+    "callbacks->write(userdata,\"1+3-2*10=\",9);\nsmart_tpl_output_number(callbacks,userdata,((1+3)-(2*10)));\n"
+    "callbacks->write(userdata,\"\\n(1+3-2)*10=\",12);\nsmart_tpl_output_number(callbacks,userdata,(((1+3)-2)*10));\n}\n"
     "int personalized = 0;\n"
     "const char *mode = \"raw\";\n");
     EXPECT_EQ(expectedOutput, tpl.compile());
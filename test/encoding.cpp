@@ -75,8 +75,8 @@ TEST(Encoding, HtmlEncodingRawOverride)
     string expectedOutput("#include <smarttpl/callbacks.h>\n"
     "void show_template(struct smart_tpl_callbacks *callbacks, void *userdata) {\n"
     "callbacks->write(userdata,\"<b>This is \",11);\n"
-    "callbacks->output(userdata,callbacks->modify_variable(userdata,"
-    "callbacks->variable(userdata,\"bold\",4),callbacks->modifier(userdata,\"raw\",3),NULL),0);\n"
+    "callbacks->output_pipeline(userdata,"
+    "callbacks->variable(userdata,\"bold\",4),callbacks->modifier(userdata,\"raw\",3),NULL,0);\n"
     "callbacks->write(userdata,\"</b>\",4);\n}\nint personalized = 1;\nconst char *mode = \"html\";\n");
     EXPECT_EQ(expectedOutput, tpl.compile());
     EXPECT_TRUE(tpl.personalized());
@@ -139,4 +139,13 @@ TEST(InvalidSyntax, BreakDownAssign)
         EXPECT_THROW(Template((Buffer(tpl))), CompileError)
                      << "The following template didn't fail to compile:" << std::endl << std::endl << tpl << std::endl;
     }
-}
\ No newline at end of file
+}
+
+TEST(InvalidSyntax, AssignForCounter)
+{
+    // the counter of a for loop can not get another value inside the loop
+    EXPECT_THROW(Template((Buffer("{for $i = 1 to 3}{assign 5 to $i}{/for}"))), CompileError);
+    EXPECT_THROW(Template((Buffer("{for $i = 1 to 3}{if true}{foreach $list as $i}{/foreach}{/if}{/for}"))), CompileError);
+    EXPECT_THROW(Template((Buffer("{for $i = 1 to 3}{for $i = 1 to 2}{/for}{/for}"))), CompileError);
+    EXPECT_NO_THROW(Template((Buffer("{for $i = 1 to 3}{assign $i to $j}{/for}{assign 5 to $i}"))));
+}
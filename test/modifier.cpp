@@ -626,6 +626,25 @@ TEST(Modifier, TailList)
     }
 }
 
+TEST(Modifier, RangeKeepsOrder)
+{
+    string input("{foreach $var|range:8:3 as $key => $value}{$key}={$value},{/foreach}{$var|range:8:3|count}");
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("var", { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 });
+
+    // the numeric keys of the original list are kept, and so is their order
+    string expectedOutput("7=8,8=9,9=10,10=11,4");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
 TEST(Modifer, RangeNoArray)
 {
     string input("{$var|range:0:1}");
@@ -160,4 +160,151 @@ TEST(Modifiers, ParametersDouble)
     EXPECT_EQ(expectedOutput, tpl.process(data));
 
     compile(tpl);
-}
\ No newline at end of file
+}
+
+class ExclaimModifier : public Modifier {
+public:
+    virtual ~ExclaimModifier() {};
+
+    bool apply(const Value &input, const Parameters &params, VariantValue &result) override
+    {
+        // leave empty values alone
+        if (input.toString().empty()) return false;
+
+        result = input.toString() + "!";
+        return true;
+    }
+
+    VariantValue modify(const Value &input, const Parameters &params) override
+    {
+        // the old interface throws when the input stays the same
+        VariantValue result;
+        if (!apply(input, params, result)) throw NoModification();
+        return result;
+    }
+};
+
+TEST(Modifiers, ApplyWithoutExceptions)
+{
+    string input("{$var|exclaim}{$empty|exclaim|default:\"none\"}{$var|exclaim|test:\"test\"}");
+    Template tpl((Buffer(input)));
+
+    ExclaimModifier exclaim;
+    TestModifier test(TestModifier::StringMode);
+    Data data;
+    data.modifier("exclaim", &exclaim)
+        .modifier("test", &test)
+        .assign("var", "Test")
+        .assign("empty", "");
+
+    string expectedOutput("Test!noneTest!");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    // the old interface is still available
+    EXPECT_EQ("Test!", exclaim.modify(VariantValue("Test"), Parameters()).toString());
+    EXPECT_THROW(exclaim.modify(VariantValue(""), Parameters()), Modifier::NoModification);
+
+    compile(tpl);
+}
+
+TEST(Modifiers, StringPipeline)
+{
+    string input("{assign $var|trim|upper to $x}{$x|lower|ucfirst}-{$x}-{$var|trim|default:\"none\"|lower}-"
+                 "{$empty|trim|default:\"none\"|upper}-{$var|trim|escape}-{if $var|trim|lower == \"<b>hi</b>\"}equal{/if}");
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("var", "  <B>Hi</B> ")
+        .assign("empty", "  ");
+
+    string expectedOutput("<b>hi</b>-<B>HI</B>-<b>hi</b>-NONE-&lt;B&gt;Hi&lt;/B&gt;-equal");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(Modifiers, StringPipelineLoop)
+{
+    string input("{foreach $list as $item}{$item|trim|lower}/{$item|trim|strlen}/{$item|trim|upper|cat:\"!\"};{/foreach}");
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("list", std::vector<VariantValue>({ "  A ", " Bb", "C  " }));
+
+    // the buffers of finished pipelines are reused by the next iterations
+    string expectedOutput("a/1/A!;bb/2/BB!;c/1/C!;");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(Modifiers, StringPipelineConsumed)
+{
+    string input("{foreach $list as $item}{assign $item|trim|upper to $x}{if $item|trim|lower}{$x}{/if}/{/foreach}{$x}");
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("list", std::vector<VariantValue>({ " a ", "  ", " c " }));
+
+    // the assigned strings stay valid when the buffers of the pipelines are reused
+    string expectedOutput("A//C/C");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(Modifiers, OverrideBuiltin)
+{
+    string input("{$var|upper}{$var|lower}{$var|toupper}");
+    Template tpl((Buffer(input)));
+
+    ExclaimModifier exclaim;
+    Data data;
+    data.modifier("upper", &exclaim)
+        .assign("var", "Test");
+
+    // the other built-in modifiers are still available
+    string expectedOutput("Test!testTEST");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    // copies use the same modifiers
+    Data copy(data);
+    EXPECT_EQ(expectedOutput, tpl.process(copy));
+
+    compile(tpl);
+}
+
+TEST(Modifiers, OverrideBuiltinLoop)
+{
+    string input("{foreach $item in $list}{$var|upper}{$var|lower|upper}{/foreach}");
+    Template tpl((Buffer(input)));
+
+    ExclaimModifier exclaim;
+    Data data;
+    data.modifier("upper", &exclaim)
+        .assign("var", "Test")
+        .assign("list", std::vector<VariantValue>({ 1, 2 }));
+
+    // the filters do not change inside the loop, but they may only be evaluated
+    // before the loop when they use the built-in modifiers
+    string expectedOutput("Test!test!Test!test!");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
@@ -10,6 +10,8 @@
 
 #include <gtest/gtest.h>
 #include <../smarttpl.h>
+#include <fstream>
+#include <unistd.h>
 
 #include "ccode.h"
 
@@ -123,6 +125,30 @@ TEST(RunTime, ForEachWithKeysElse)
     }
 }
 
+TEST(RunTime, ForEachVectorVariables)
+{
+    string input("{foreach $rows as $key => $row}{$key}:{$row.id}{foreach $row.tags as $tag}{$tag}{/foreach},{/foreach}{$key}/{$row.id}|"
+                 "{foreach $rows as $row}{$row.id}{assign \"x\" to $row}{$row}{/foreach}");
+    Template tpl((Buffer(input)));
+
+    std::vector<VariantValue> rows;
+    for (int i = 0; i < 3; ++i) rows.push_back(std::map<std::string, VariantValue>({{ "id", i * 10 }, { "tags", std::vector<VariantValue>({ "a", "b" }) }}));
+
+    Data data;
+    data.assign("rows", rows);
+
+    // the variables are read from the vector, and keep the last element after the loop,
+    // unless they are assigned inside the loop
+    string expectedOutput("0:0ab,1:10ab,2:20ab,2/20|0x10x20x");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
 TEST(RunTime, If)
 {
     string input("{if true}true{else}false{/if}");
@@ -787,3 +813,678 @@ TEST(RunTime, IfWithModifierNumberComparison)
         EXPECT_EQ(expectedOutput2, library.process(data2));
     }
 }
+
+TEST(RunTime, SharedLibraryCache)
+{
+    string input("{$var}");
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("var", "value");
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        // the preloaded library stays in memory, so it gets a file of its own
+        const char *preloaded = "/tmp/test-preloaded.so";
+        {
+            std::ifstream input(SHARED_LIBRARY, std::ios::binary);
+            std::ofstream output(preloaded, std::ios::binary | std::ios::trunc);
+            output << input.rdbuf();
+        }
+
+        // preloading binds all symbols up front, templates created afterwards share the library
+        Template::preload(preloaded);
+
+        Template library1((File(preloaded)));
+        Template library2((File(preloaded)));
+        EXPECT_EQ("value", library1.process(data));
+        EXPECT_EQ("value", library2.process(data));
+
+        // a library that is replaced on disk is loaded again, even while the old one is in use
+        Template other((Buffer("other {$var}")));
+        if (compile(other))
+        {
+            Template library3(File(SHARED_LIBRARY));
+            Template library4(File(SHARED_LIBRARY));
+            EXPECT_EQ("other value", library3.process(data));
+            EXPECT_EQ("other value", library4.process(data));
+        }
+
+        // the preloaded library stays in memory, even without the file
+        unlink(preloaded);
+        EXPECT_EQ("value", library1.process(data));
+    }
+
+    EXPECT_THROW(Template::preload("/tmp/does-not-exist.so"), std::runtime_error);
+}
+
+TEST(RunTime, ScalarConversions)
+{
+    string input("{$int + $double}|{$bool + 1}|{$null + 1}|{if $double}double{/if}|{if $null}null{/if}|{$custom * 2}|{if $custom > $int}custom{/if}");
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("int", 5)
+        .assign("double", 2.5)
+        .assign("bool", true)
+        .assign("null", nullptr)
+        .callback("custom", []() { return 10; });
+
+    string expectedOutput("7.500000|2|1|double||20|custom");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(RunTime, InlineStrings)
+{
+    string input("{$short}|{$long}|{$short|toupper}|{if $short == \"short\"}equal{/if}|{$number + 1}|{foreach $list as $item}{$item}{/foreach}");
+    Template tpl((Buffer(input)));
+
+    // short strings are stored inline in the variant, long ones are allocated
+    VariantValue shortString("short");
+    VariantValue longString("a string that does not fit in the buffer");
+    VariantValue copy(shortString);
+
+    Data data;
+    data.assign("short", copy)
+        .assign("long", longString)
+        .assign("number", VariantValue("41"))
+        .assign("list", VariantValue({ "a", 1, 2.5, true, nullptr }));
+
+    string expectedOutput("short|a string that does not fit in the buffer|SHORT|equal|42|a12.500000true");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(RunTime, SharedNullAndBoolean)
+{
+    string input("{foreach $list as $key => $item}{$item.missing}{if $item}{$key}{/if}{/foreach}{assign $missing.member to $x}{assign true to $y}{if $y}y{/if}{$x}");
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("list", VariantValue({ true, false, nullptr, true }));
+
+    string expectedOutput("03y");
+
+    // process the template a couple of times, the shared null and boolean
+    // values should survive every run
+    for (int i = 0; i < 3; ++i) EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        for (int i = 0; i < 3; ++i) EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(RunTime, Iterable)
+{
+    string input("{foreach $rows as $key => $row}{$key}:{$row.name}{if $row.amount > 10}!{/if} {/foreach}|{foreach $nothing as $row}{$row}{foreachelse}empty{/foreach}");
+    Template tpl((Buffer(input)));
+
+    // number of generators that were created
+    int generators = 0;
+
+    Data data;
+    data.iterable("rows", [&generators]() -> Generator {
+
+        // this is called every time the template iterates over $rows
+        auto position = std::make_shared<int>(0);
+        ++generators;
+
+        // the generator that produces the rows
+        return [position](VariantValue &row) -> bool {
+            if (*position == 5) return false;
+            row = std::map<std::string, VariantValue>({{"name", "row" + to_string(*position)}, {"amount", *position * 5}});
+            ++*position;
+            return true;
+        };
+    }, 2).iterable("nothing", []() -> Generator {
+        return [](VariantValue &value) -> bool { return false; };
+    });
+
+    string expectedOutput("0:row0 1:row1 2:row2 3:row3! 4:row4! |empty");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    EXPECT_EQ(1, generators);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+        EXPECT_EQ(2, generators);
+    }
+}
+
+/**
+ *  String that keeps track of the number of instances that are alive
+ */
+class CountedValue : public StringValue
+{
+private:
+    int *_alive;
+    int *_peak;
+
+public:
+    CountedValue(int value, int *alive, int *peak) : StringValue(to_string(value)), _alive(alive), _peak(peak) { *_peak = std::max(*_peak, ++*_alive); }
+    virtual ~CountedValue() { --*_alive; }
+};
+
+TEST(RunTime, IterableMemory)
+{
+    string input("{foreach $rows as $row}{$row},{/foreach}");
+    Template tpl((Buffer(input)));
+
+    // number of values that are alive, and the highest number that ever was
+    int alive = 0, peak = 0;
+
+    Data data;
+    data.iterable("rows", [&alive, &peak]() -> Generator {
+        auto position = std::make_shared<int>(0);
+        return [position, &alive, &peak](VariantValue &row) -> bool {
+            if (*position == 1000) return false;
+            row = std::shared_ptr<Value>(std::make_shared<CountedValue>((*position)++, &alive, &peak));
+            return true;
+        };
+    }, 16);
+
+    string expectedOutput;
+    for (int i = 0; i < 1000; ++i) expectedOutput.append(to_string(i)).append(",");
+
+    // the values are released while iterating, only a couple of chunks are alive at once
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    EXPECT_GT(100, peak);
+    EXPECT_EQ(0, alive);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        peak = 0;
+        EXPECT_EQ(expectedOutput, library.process(data));
+        EXPECT_GT(100, peak);
+        EXPECT_EQ(0, alive);
+    }
+}
+
+/**
+ *  Iterator that produces the numbers 0 to 99 in batches, and counts how
+ *  often it is asked for a batch
+ */
+class BatchIterator : public Iterator
+{
+private:
+    int _position = 0;
+    int *_batches;
+
+public:
+    BatchIterator(int *batches) : _batches(batches) {}
+    bool valid() const override { return _position < 100; }
+    void next() override { ++_position; }
+    VariantValue value() const override { return _position; }
+    VariantValue key() const override { return _position; }
+
+    size_t fetch(VariantValue *keys, VariantValue *values, size_t max) override
+    {
+        ++*_batches;
+        size_t count = 0;
+        for (; count < max && _position < 100; ++count, ++_position)
+        {
+            if (keys) keys[count] = _position;
+            values[count] = _position * 2;
+        }
+        return count;
+    }
+};
+
+/**
+ *  Value that can be iterated with the batch iterator
+ */
+class BatchValue : public Value
+{
+private:
+    int *_batches;
+
+public:
+    BatchValue(int *batches) : _batches(batches) {}
+    std::string toString() const override { return ""; }
+    numeric_t toNumeric() const override { return 0; }
+    bool toBoolean() const override { return true; }
+    double toDouble() const override { return 0.0; }
+    VariantValue member(const char *name, size_t size) const override { return nullptr; }
+    size_t memberCount() const override { return 100; }
+    VariantValue member(size_t position) const override { return nullptr; }
+    Iterator *iterator() const override { return new BatchIterator(_batches); }
+};
+
+TEST(RunTime, BatchIterator)
+{
+    string input("{foreach $numbers as $key => $value}{if $key == 99}{$value}{/if}{/foreach}");
+    Template tpl((Buffer(input)));
+
+    int batches = 0;
+    BatchValue numbers(&batches);
+
+    Data data;
+    data.assignValue("numbers", &numbers);
+
+    // the elements are fetched in batches, and not one by one
+    string expectedOutput("198");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    EXPECT_GT(batches, 1);
+    EXPECT_LT(batches, 20);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+/**
+ *  Iterator written for older versions, that does not override fetch(), and
+ *  that counts the number of elements that it produced
+ */
+class LegacyIterator : public Iterator
+{
+private:
+    int _position = 0;
+    int *_produced;
+
+public:
+    LegacyIterator(int *produced) : _produced(produced) {}
+    bool valid() const override { return _position < 3; }
+    void next() override { ++_position; }
+    VariantValue value() const override { ++*_produced; return _position; }
+    VariantValue key() const override { return _position; }
+};
+
+/**
+ *  Value that can be iterated with the legacy iterator
+ */
+class LegacyValue : public BatchValue
+{
+private:
+    int *_produced;
+
+public:
+    LegacyValue(int *produced) : BatchValue(nullptr), _produced(produced) {}
+    size_t memberCount() const override { return 3; }
+    Iterator *iterator() const override { return new LegacyIterator(_produced); }
+};
+
+TEST(RunTime, LegacyIterator)
+{
+    string input("{foreach $numbers as $value}{$value}:{$produced},{/foreach}");
+    Template tpl((Buffer(input)));
+
+    int produced = 0;
+    LegacyValue numbers(&produced);
+
+    Data data;
+    data.assignValue("numbers", &numbers)
+        .callback("produced", [&produced]() -> VariantValue { return produced; }, Caching::None);
+
+    // iterators that do not fetch in batches are not asked for elements in advance
+    string expectedOutput("0:1,1:2,2:3,");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        produced = 0;
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+class GreetingValue : public Value
+{
+public:
+    GreetingValue() : Value(Type::Map) {}
+    std::string toString() const override { return ""; }
+    numeric_t toNumeric() const override { return 0; }
+    bool toBoolean() const override { return true; }
+    double toDouble() const override { return 0.0; }
+    VariantValue member(const char *name, size_t size) const override { return std::map<std::string, VariantValue>({{ "text", "hello " + std::string(name, size) }}); }
+    size_t memberCount() const override { return 0; }
+    VariantValue member(size_t position) const override { return nullptr; }
+    Iterator *iterator() const override { return nullptr; }
+};
+
+TEST(RunTime, MemberPath)
+{
+    string input("{$user.address.city} {$user.orders[1].id} {$user.orders[5].id}{$user.name.first}|{$greeting.world.text}|"
+                 "{foreach $user.orders as $order}{assign $order.lines[0] to $line}{$line}{/foreach}{$line}");
+    Template tpl((Buffer(input)));
+
+    std::map<std::string, VariantValue> address({{ "city", "Amsterdam" }});
+    std::vector<VariantValue> orders;
+    for (int i = 0; i < 3; ++i) orders.push_back(std::map<std::string, VariantValue>({{ "id", i * 10 }, { "lines", std::vector<VariantValue>({ i, i + 1 }) }}));
+    std::map<std::string, VariantValue> user({{ "address", address }, { "name", "john" }, { "orders", orders }});
+
+    GreetingValue greeting;
+
+    Data data;
+    data.assign("user", user)
+        .assignValue("greeting", &greeting);
+
+    // members of members are looked up with a single call, also when they
+    // do not exist, and for values that do not expose their members directly
+    string expectedOutput("Amsterdam 10 |hello world|0122");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(RunTime, LoopInvariants)
+{
+    string input("{foreach $items as $item}{$currency}{$shop.url}{$settings|upper}{$item}{$last}{assign $item to $last}"
+                 "{$counted}{if $item == \"z\"}{$unused}{/if}"
+                 "{foreach $tags as $tag}{$item}{$tag}{$currency}{/foreach};{/foreach}|"
+                 "{foreach $none as $x}{$settings|upper}{foreachelse}none{/foreach}");
+    Template tpl((Buffer(input)));
+
+    // number of times that the resolver was asked for each variable
+    std::map<std::string, int> lookups;
+    VariantValue resolved("!");
+
+    Data data;
+    data.assign("items", std::vector<VariantValue>({ "a", "b", "c" }))
+        .assign("tags", std::vector<VariantValue>({ 1, 2 }))
+        .assign("currency", "EUR")
+        .assign("shop", std::map<std::string, VariantValue>({{ "url", "x.com" }}))
+        .assign("settings", "on")
+        .resolver([&lookups, &resolved](const char *name, size_t size) -> const Value * {
+            std::string key(name, size);
+            ++lookups[key];
+            return key == "counted" || key == "unused" ? &resolved : nullptr;
+        });
+
+    // the outer variables are evaluated once before the loop, but names that
+    // are assigned inside the loop and the loop variables are not, and neither
+    // are the variables that are not evaluated on every iteration
+    string expectedOutput("EURx.comONa!a1EURa2EUR;EURx.comONba!b1EURb2EUR;EURx.comONcb!c1EURc2EUR;|none");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    EXPECT_EQ(1, lookups["counted"]);
+    EXPECT_EQ(0, lookups["unused"]);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+        EXPECT_EQ(2, lookups["counted"]);
+        EXPECT_EQ(0, lookups["unused"]);
+    }
+}
+
+TEST(RunTime, LoopProperties)
+{
+    string input("{foreach $items as $item}{if !$item@first}, {/if}{$item@index}:{$item}{if $item@iteration % 2 == 0}*{/if}{/foreach}|"
+                 "{foreach $map as $key => $value}{$value@iteration}/{$value@total}{if $value@last}.{/if}{/foreach}");
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("items", std::vector<VariantValue>({ "a", "b", "c" }))
+        .assign("map", std::map<std::string, VariantValue>({{ "x", 1 }, { "y", 2 }}));
+
+    // vectors and maps are iterated differently, but they have the same properties
+    string expectedOutput("0:a, 1:b*, 2:c|1/22/2.");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(RunTime, LoopPropertiesIterable)
+{
+    string input("{foreach $rows as $row}{$row}/{$row@total}{if $row@last}.{/if},{/foreach}");
+    Template tpl((Buffer(input)));
+
+    // number of generators that were created
+    int generators = 0;
+
+    Data data;
+    data.iterable("rows", [&generators]() -> Generator {
+
+        // this is called every time the template iterates over $rows
+        auto position = std::make_shared<int>(0);
+        ++generators;
+
+        // the generator that produces the rows
+        return [position](VariantValue &row) -> bool {
+            if (*position == 3) return false;
+            row = "row" + to_string((*position)++);
+            return true;
+        };
+    });
+
+    // generators do not know their number of elements, so a second generator counts them
+    string expectedOutput("row0/3,row1/3,row2/3.,");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+    EXPECT_EQ(2, generators);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+        EXPECT_EQ(4, generators);
+    }
+}
+
+TEST(RunTime, ForLoop)
+{
+    string input("{for $i = 1 to 5}{$i}{/for}|{for $i = 10 to 1 step -3}{$i},{/for}|{for $i = 1 to $n}{if $i % 2}*{else}-{/if}{/for}|"
+                 "{for $i = 3 to 1}x{/for}|{for $i = 1 to 2}{$i|cat:\"!\"}{for $j = $i to 2}{$i}{$j}{/for}{/for}|"
+                 "{$i}{$j}{for $n = 5 to 1}{/for}{$n}");
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("n", 4);
+
+    // the counters are native numbers, they only become variables when a
+    // modifier is applied to them, and they keep their last value after the
+    // loop, unless the loop did not run at all
+    string expectedOutput("12345|10,7,4,1,|*-*-||1!11122!22|224");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(RunTime, LayeredData)
+{
+    string input("{$greeting} {$name|toupper}{if $admin} (admin){/if}");
+    Template tpl((Buffer(input)));
+
+    // the data that is shared by all recipients
+    Data shared;
+    shared.assign("greeting", "Hello");
+    shared.assign("name", "nobody");
+
+    // the data of a single recipient, the rest comes from the shared data
+    Data recipient(&shared);
+    recipient.assign("name", "john");
+    recipient.assign("admin", true);
+
+    EXPECT_EQ("Hello JOHN (admin)", tpl.process(recipient));
+    EXPECT_EQ("Hello NOBODY", tpl.process(shared));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ("Hello JOHN (admin)", library.process(recipient));
+        EXPECT_EQ("Hello NOBODY", library.process(shared));
+    }
+}
+
+TEST(RunTime, Resolver)
+{
+    string input("{$firstname} {$lastname}{if $unknown}?{/if}{if $firstname == \"John\"}!{/if}");
+    Template tpl((Buffer(input)));
+
+    // the fields that can be loaded, and the number of times they were asked for
+    std::map<std::string, VariantValue> fields;
+    fields["firstname"] = "John";
+    fields["lastname"] = "Doe";
+    std::map<std::string, int> calls;
+
+    // resolver that only loads the fields that are used
+    auto resolver = [&fields, &calls](const char *name, size_t size) -> const Value * {
+        std::string key(name, size);
+        calls[key] += 1;
+        auto iter = fields.find(key);
+        return iter == fields.end() ? nullptr : &iter->second;
+    };
+
+    // assigned variables are never resolved
+    Data data;
+    data.assign("lastname", "Smith");
+    data.resolver(resolver);
+
+    EXPECT_EQ("John Smith!", tpl.process(data));
+    EXPECT_EQ(0, calls["lastname"]);
+    EXPECT_LE(1, calls["unknown"]);
+
+    // with caching every variable is resolved once per run
+    Data cached;
+    cached.resolver(resolver, true);
+    calls.clear();
+
+    EXPECT_EQ("John Doe!", tpl.process(cached));
+    EXPECT_EQ(1, calls["firstname"]);
+    EXPECT_EQ(1, calls["unknown"]);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        calls.clear();
+        EXPECT_EQ("John Doe!", library.process(cached));
+        EXPECT_EQ(1, calls["firstname"]);
+        EXPECT_EQ("John Smith!", library.process(data));
+    }
+}
+
+TEST(RunTime, LayeredResolver)
+{
+    string input("{$greeting} {$name}");
+    Template tpl((Buffer(input)));
+
+    // the data that is shared by all recipients
+    Data shared;
+    shared.assign("greeting", "Hello");
+
+    // the resolver of a single recipient, and the variables it was asked for
+    std::map<std::string, int> calls;
+    auto resolver = [&calls](const char *name, size_t size) -> const Value * {
+        static VariantValue john("john");
+        std::string key(name, size);
+        calls[key] += 1;
+        return key == "greeting" || key == "name" ? &john : nullptr;
+    };
+
+    // variables assigned to the parent take precedence over the resolver of the child
+    Data recipient(&shared);
+    recipient.resolver(resolver);
+
+    EXPECT_EQ("Hello john", tpl.process(recipient));
+    EXPECT_EQ(0, calls["greeting"]);
+    EXPECT_EQ(1, calls["name"]);
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        calls.clear();
+        EXPECT_EQ("Hello john", library.process(recipient));
+        EXPECT_EQ(0, calls["greeting"]);
+    }
+}
+
+TEST(RunTime, Json)
+{
+    string input("{$contact.name} ({$contact.age + 1}){if $contact.vip} vip{/if}: "
+                 "{foreach $contact.orders as $order}{$order.id}={$order.total} {/foreach}"
+                 "{foreach $contact.tags as $index => $tag}{$index}:{$tag},{/foreach} {$contact.orders|count}{$contact.missing}");
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assignJson("contact", R"({
+        "name": "Jöhn \"Doe\"",
+        "age": 41,
+        "vip": true,
+        "orders": [ { "id": 1, "total": 9.5 }, { "id": 2, "total": 20 } ],
+        "tags": [ "a", "b" ]
+    })");
+
+    string expectedOutput("Jöhn \"Doe\" (42) vip: 1=9.500000 2=20 0:a,1:b, 2");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(RunTime, JsonLargeObject)
+{
+    string input("{$object.k3} {$object.k17} {$object.k1} {$object.nested.list|count}{$object.missing}");
+    Template tpl((Buffer(input)));
+
+    // an object with enough members to be indexed by name, the first of two equal names wins
+    string json("{");
+    for (int i = 0; i < 20; ++i) json.append("\"k" + std::to_string(i) + "\": " + std::to_string(i) + ", ");
+    json.append(R"("k\u0031": 99, "nested": { "list": [ 1, 2, 3 ] } })");
+
+    Data data;
+    data.assignJson("object", json);
+
+    string expectedOutput("3 17 1 3");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(RunTime, MapInsert)
+{
+    string input("{foreach $map as $key => $value}{$key}={$value},{/foreach} {$map.k5} {$map.k10}");
+    Template tpl((Buffer(input)));
+
+    // insert the keys out of order, and a duplicate that should be ignored
+    MapValue map;
+    for (int i = 10; i >= 0; --i) map.insert("k" + to_string(i), i);
+    map.insert("k5", 50);
+
+    Data data;
+    data.assignValue("map", &map);
+
+    string expectedOutput("k0=0,k1=1,k10=10,k2=2,k3=3,k4=4,k5=5,k6=6,k7=7,k8=8,k9=9, 5 10");
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
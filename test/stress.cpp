@@ -16,21 +16,48 @@ using namespace SmartTpl;
 using namespace std;
 
 /**
- *  This test will attempt to compile about 1000 chained modifiers, which should
- *  succeed just fine. It can go higher just fine (without causing stack overflow)
- *  but that increases the time of this time by quite a bit.
+ *  Many small raw fragments and numbers, the output is much larger than the
+ *  initial output buffer, so that it has to grow a couple of times while
+ *  the template is running
  */
-TEST(Stress, ChainedModifiers)
+TEST(Stress, ManyRawFragments)
 {
-    string input("{$var");
-    for (int i = 0; i < 500; ++i) input.append("|upper|lower");
-    input.push_back('}');
+    string input;
+    string expectedOutput;
+    for (int i = 0; i < 2000; ++i)
+    {
+        input.append("<td>{$var}</td>{").append(to_string(i)).append(" - 1000}\n");
+        expectedOutput.append("<td>value</td>").append(to_string(i - 1000)).append("\n");
+    }
+    Template tpl((Buffer(input)));
+
+    Data data;
+    data.assign("var", "value");
+
+    EXPECT_EQ(expectedOutput, tpl.process(data));
+
+    if (compile(tpl)) // This will compile the Template into a shared library
+    {
+        Template library(File(SHARED_LIBRARY)); // Here we load that shared library
+        EXPECT_EQ(expectedOutput, library.process(data));
+    }
+}
+
+TEST(Stress, LargeForEach)
+{
+    string input("{foreach $list as $item}{if $item == 99999}{foreach $map as $key => $value}{$key}{$value}{/foreach}{/if}{/foreach}");
     Template tpl((Buffer(input)));
 
+    // a big list, and a map that is iterated from within the loop
+    vector<VariantValue> list;
+    for (int i = 0; i < 100000; ++i) list.push_back(i);
+    std::map<std::string, VariantValue> map({{"a", 1}, {"b", 2}});
+
     Data data;
-    data.assign("var", "VaRiAbLe");
+    data.assign("list", std::move(list))
+        .assign("map", std::move(map));
 
-    string expectedOutput("variable");
+    string expectedOutput("a1b2");
     EXPECT_EQ(expectedOutput, tpl.process(data));
 
     if (compile(tpl)) // This will compile the Template into a shared library